@@ -0,0 +1,63 @@
+//===- include/draw/alpha8.hpp ----------------------------*- mode: C++ -*-===//
+//*        _       _            ___   *
+//*   __ _| |_ __ | |__   __ _ ( _ )  *
+//*  / _` | | '_ \| '_ \ / _` |/ _ \  *
+//* | (_| | | |_) | | | | (_| | (_) | *
+//*  \__,_|_| .__/|_| |_|\__,_|\___/  *
+//*         |_|                       *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+#ifndef DRAW_ALPHA8_HPP
+#define DRAW_ALPHA8_HPP
+
+#include <cstdint>
+
+#include "draw/basic_bitmap.hpp"
+#include "draw/types.hpp"
+
+namespace draw {
+
+/// The largest radius accepted by the box blurs of alpha8 and bitmap32. Each pass keeps the last radius + 1 original
+/// values of a line on the stack so that it can work in place.
+constexpr auto max_blur_radius = 31U;
+
+/// A coverage mask which may be used to apply a color to a bitmap32 (see bitmap32::fill_mask()).
+class alpha8 : public basic_bitmap<alpha8_format> {
+public:
+  using basic_bitmap::basic_bitmap;
+
+  /// Blurs an area of the mask by applying a box filter horizontally and then vertically. Each pass costs the same
+  /// regardless of radius; three passes closely approximate a gaussian. Values beyond the edges of \p r are taken
+  /// to be those of the nearest pixel inside it; pixels outside of \p r are neither read nor modified.
+  ///
+  /// \param r  The (inclusive) area to be blurred
+  /// \param radius  The number of pixels either side of each pixel that contribute to its value. Must not exceed
+  ///   max_blur_radius.
+  /// \param passes  The number of times that the box filter is applied
+  void box_blur(rect const& r, unsigned radius, unsigned passes = 3U);
+};
+
+}  // end namespace draw
+
+#endif  // DRAW_ALPHA8_HPP
@@ -0,0 +1,507 @@
+//===- include/draw/basic_bitmap.hpp ----------------------*- mode: C++ -*-===//
+//*  _               _        _     _ _                          *
+//* | |__   __ _ ___(_) ___  | |__ (_) |_ _ __ ___   __ _ _ __   *
+//* | '_ \ / _` / __| |/ __| | '_ \| | __| '_ ` _ \ / _` | '_ \  *
+//* | |_) | (_| \__ \ | (__  | |_) | | |_| | | | | | (_| | |_) | *
+//* |_.__/ \__,_|___/_|\___| |_.__/|_|\__|_| |_| |_|\__,_| .__/  *
+//*                                                      |_|     *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+#ifndef DRAW_BASIC_BITMAP_HPP
+#define DRAW_BASIC_BITMAP_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+
+#include "draw/types.hpp"
+
+namespace draw {
+
+// Pixel formats
+// ~~~~~~~~~~~~~
+// A pixel format supplies the type of the frame store elements, the value with which pixels are painted, and the
+// kernels that operate on a row of pixels. basic_bitmap<> does the clipping, dirty tracking, and line drawing
+// common to every format and calls on these kernels to modify pixels.
+//
+// Patterns are applied uniformly: a pixel whose pattern bit is set is painted with the foreground value and one whose
+// bit is clear is painted with the background value if one is given or is otherwise left unchanged.
+
+template <typename Format>
+concept bitmap_format = requires(typename Format::storage_type* row, typename Format::value_type const& v,
+                                 std::optional<typename Format::value_type> const& bg) {
+  { Format::stride(std::uint16_t{}) } -> std::convertible_to<std::size_t>;
+  Format::plot(row, 0U, v);
+  Format::span(row, 0U, 0U, std::byte{}, v, bg);
+};
+
+/// Pixels of 1, 2, or 4 bits packed into bytes with the left-most pixel in the most significant bits. A value of 0 is
+/// the paper (white) level and max_value is full ink (black).
+template <unsigned Bits>
+  requires(Bits == 1U || Bits == 2U || Bits == 4U)
+struct packed_format {
+  using storage_type = std::byte;
+  using value_type = std::uint8_t;
+
+  static constexpr unsigned bits_per_pixel = Bits;
+  static constexpr unsigned pixels_per_byte = 8U / Bits;
+  static constexpr auto max_value = static_cast<value_type>((1U << Bits) - 1U);
+
+  /// \returns The number of bytes required for a row of \p width pixels.
+  [[nodiscard]] static constexpr std::size_t stride(std::uint16_t const width) noexcept {
+    return (static_cast<std::size_t>(width) * Bits + 7U) / 8U;
+  }
+  /// \returns A byte in which every pixel has the value \p v.
+  [[nodiscard]] static constexpr std::byte replicate(value_type const v) noexcept {
+    assert(v <= max_value && "pixel value is out of range");
+    return static_cast<std::byte>(v * (0xFFU / max_value));
+  }
+  /// Expands each bit of a pattern row to the width of a pixel. Element n of the result covers the n'th group of
+  /// pixels_per_byte pattern bits starting from the most significant.
+  [[nodiscard]] static constexpr std::array<std::byte, Bits> expand_pattern(std::byte const pattern) noexcept {
+    std::array<std::byte, Bits> result{};
+    for (auto bit = 0U; bit < 8U; ++bit) {
+      if ((pattern & (std::byte{0x80} >> bit)) != std::byte{0}) {
+        auto const shift = (pixels_per_byte - 1U - bit % pixels_per_byte) * Bits;
+        result[bit / pixels_per_byte] |= static_cast<std::byte>(max_value << shift);
+      }
+    }
+    return result;
+  }
+
+  [[nodiscard]] static constexpr value_type get(storage_type const* DRAW_NONNULL row, unsigned const x) noexcept {
+    auto const shift = (pixels_per_byte - 1U - x % pixels_per_byte) * Bits;
+    return static_cast<value_type>((std::to_integer<unsigned>(row[x / pixels_per_byte]) >> shift) & max_value);
+  }
+  static constexpr void plot(storage_type* DRAW_NONNULL row, unsigned const x, value_type const v) noexcept {
+    assert(v <= max_value && "pixel value is out of range");
+    auto const shift = (pixels_per_byte - 1U - x % pixels_per_byte) * Bits;
+    auto const mask = static_cast<std::byte>(max_value << shift);
+    auto& b = row[x / pixels_per_byte];
+    b = (b & ~mask) | (static_cast<std::byte>(v << shift) & mask);
+  }
+  /// Paints pixels \p x0 to \p x1 (inclusive) of a row a byte at a time.
+  static constexpr void span(storage_type* DRAW_NONNULL row, unsigned const x0, unsigned const x1,
+                             std::byte const pattern, value_type const fg,
+                             std::optional<value_type> const& bg) noexcept {
+    assert(x0 <= x1);
+    auto const pat = expand_pattern(pattern);
+    auto const ink = replicate(fg);
+    auto const paper = bg ? replicate(*bg) : std::byte{0};
+    auto const first = x0 / pixels_per_byte;
+    auto const last = x1 / pixels_per_byte;
+    for (auto index = first; index <= last; ++index) {
+      // Masks select the pixels of the first and last bytes that lie within the span.
+      auto edge = std::byte{0xFF};
+      if (index == first) {
+        edge &= std::byte{0xFF} >> (x0 % pixels_per_byte * Bits);
+      }
+      if (index == last) {
+        edge &= std::byte{0xFF} << ((pixels_per_byte - 1U - x1 % pixels_per_byte) * Bits);
+      }
+      auto const pm = pat[index % Bits];
+      auto& b = row[index];
+      auto const value = (pm & ink) | (~pm & (bg ? paper : b));
+      b = (b & ~edge) | (value & edge);
+    }
+  }
+};
+
+/// Pixels which each occupy a whole element of type T and are replaced when painted.
+template <typename T> struct whole_format {
+  using storage_type = T;
+  using value_type = T;
+
+  [[nodiscard]] static constexpr std::size_t stride(std::uint16_t const width) noexcept { return width; }
+  [[nodiscard]] static constexpr value_type get(storage_type const* DRAW_NONNULL row, unsigned const x) noexcept {
+    return row[x];
+  }
+  static constexpr void plot(storage_type* DRAW_NONNULL row, unsigned const x, value_type const& v) noexcept {
+    row[x] = v;
+  }
+  static constexpr void span(storage_type* DRAW_NONNULL row, unsigned const x0, unsigned const x1,
+                             std::byte const pattern, value_type const& fg,
+                             std::optional<value_type> const& bg) noexcept {
+    assert(x0 <= x1);
+    if (pattern == std::byte{0xFF}) {
+      std::fill(row + x0, row + x1 + 1U, fg);
+      return;
+    }
+    for (auto x = x0; x <= x1; ++x) {
+      if ((pattern & (std::byte{0x80} >> (x % 8U))) != std::byte{0}) {
+        row[x] = fg;
+      } else if (bg) {
+        row[x] = *bg;
+      }
+    }
+  }
+};
+
+/// 8-bit coverage (alpha) values where 0 is uncovered and 0xFF fully covered. Painting replaces the coverage.
+struct alpha8_format : whole_format<std::uint8_t> {};
+
+using mono_format = packed_format<1>;
+using gray2_format = packed_format<2>;
+using gray4_format = packed_format<4>;
+using indexed8_format = whole_format<std::uint8_t>;
+using rgb565_format = whole_format<std::uint16_t>;
+
+/// Premultiplied 32-bit pixels. Painting composites the new value over the old.
+struct rgba_premult_format {
+  using storage_type = rgba_premult;
+  using value_type = rgba_premult;
+
+  [[nodiscard]] static constexpr std::size_t stride(std::uint16_t const width) noexcept { return width; }
+  [[nodiscard]] static constexpr value_type get(storage_type const* DRAW_NONNULL row, unsigned const x) noexcept {
+    return row[x];
+  }
+  static constexpr void plot(storage_type* DRAW_NONNULL row, unsigned const x, value_type const& v) noexcept {
+    row[x].composite(v);
+  }
+  static void span(storage_type* DRAW_NONNULL row, unsigned x0, unsigned x1, std::byte pattern, value_type const& fg,
+                   std::optional<value_type> const& bg) noexcept;
+};
+
+extern pattern const black;
+extern pattern const white;
+extern pattern const gray;
+extern pattern const light_gray;
+
+// basic bitmap
+// ~~~~~~~~~~~~
+template <bitmap_format Format> class basic_bitmap {
+public:
+  using format = Format;
+  using storage_type = typename Format::storage_type;
+  using value_type = typename Format::value_type;
+
+  constexpr basic_bitmap() noexcept = default;
+  constexpr basic_bitmap(std::span<storage_type> const& store, std::uint16_t const width, std::uint16_t const height,
+                         std::uint16_t const stride) noexcept
+      : width_{width}, height_{height}, stride_{stride}, store_{store} {
+    assert(store.size() >= this->actual_store_size() && "store is too small");
+    assert(width <= static_cast<std::uint16_t>(std::numeric_limits<coordinate>::max()) && "width is too great");
+    assert(height <= static_cast<std::uint16_t>(std::numeric_limits<coordinate>::max()) && "height is too great");
+  }
+  constexpr basic_bitmap(std::span<storage_type> const& store, std::uint16_t const width,
+                         std::uint16_t const height) noexcept
+      : basic_bitmap(store, width, height, required_stride(width)) {}
+
+  [[nodiscard]] static constexpr std::uint16_t required_stride(std::uint16_t const width) noexcept {
+    assert(width <= static_cast<std::uint16_t>(std::numeric_limits<coordinate>::max()) && "width is too great");
+    return static_cast<std::uint16_t>(Format::stride(width));
+  }
+  /// Returns the store size required for a bitmap with the supplied dimensions.
+  /// \param width  The desired width of the bitmap in pixels.
+  /// \param height  The desired height of the bitmap in pixels.
+  /// \returns The number of elements of the required frame store for a bitmap with the supplied dimensions.
+  [[nodiscard]] static constexpr std::size_t required_store_size(std::uint16_t const width,
+                                                                 std::uint16_t const height) noexcept {
+    assert(height <= static_cast<std::uint16_t>(std::numeric_limits<coordinate>::max()) && "height is too great");
+    return required_stride(width) * static_cast<std::size_t>(height);
+  }
+
+  void clear() { std::ranges::fill(this->store(), storage_type{}); }
+  /// Paints an individual pixel.
+  /// \param p The pixel to be painted
+  /// \param v The value with which the pixel is painted
+  constexpr void set(point p, value_type const& v);
+  /// \returns The value of an individual pixel which must lie within the bitmap.
+  [[nodiscard]] constexpr value_type get(point p) const;
+  /// Draws a straight line from p0 to p1.
+  /// \param p0  Coordinate of one end of the line
+  /// \param p1  Coordinate of the other end of the line
+  /// \param v  The value with which the line's pixels are painted
+  void line(point p0, point p1, value_type const& v);
+  /// Draws the outline of a rectangle.
+  /// \param r  The rectangle to be drawn
+  /// \param v  The value with which the outline's pixels are painted
+  void frame_rect(rect const& r, value_type const& v);
+  /// Fills a rectangle with a pattern. The pattern is aligned with the bitmap's origin.
+  ///
+  /// \param r  The rectangle to be filled
+  /// \param pat  The pattern with which the rectangle is to be filled
+  /// \param fg  The value of pixels corresponding to set bits in the pattern
+  /// \param bg  The value of pixels corresponding to clear bits in the pattern. If omitted, those pixels are left
+  ///   unchanged.
+  void paint_rect(rect const& r, pattern const& pat, value_type const& fg,
+                  std::optional<value_type> const& bg = std::nullopt);
+
+  [[nodiscard]] constexpr std::uint16_t width() const noexcept { return width_; }
+  [[nodiscard]] constexpr std::uint16_t height() const noexcept { return height_; }
+  [[nodiscard]] constexpr std::uint16_t stride() const noexcept { return stride_; }
+  [[nodiscard]] constexpr rect bounds() const noexcept {
+    return {.top = 0,
+            .left = 0,
+            .bottom = static_cast<coordinate>(height() - 1U),
+            .right = static_cast<coordinate>(width() - 1U)};
+  }
+  [[nodiscard]] constexpr std::optional<rect> const& dirty() const noexcept { return dirty_; }
+  constexpr void clean() noexcept { dirty_.reset(); }
+
+  [[nodiscard]] constexpr std::span<storage_type const> store() const noexcept { return store_; }
+  [[nodiscard]] constexpr std::span<storage_type> store() noexcept { return store_; }
+
+protected:
+  std::uint16_t width_ = 0U;       ///< Width of the bitmap in pixels
+  std::uint16_t height_ = 0U;      ///< Height of the bitmap in pixels
+  std::uint16_t stride_ = 0U;      ///< Number of store elements per row
+  std::span<storage_type> store_;  ///< The backing store containing the bitmap's pixel data
+  std::optional<rect> dirty_;      ///< The area of the bitmap modified since the last call to clean(), if any.
+
+  [[nodiscard]] constexpr std::size_t actual_store_size() const noexcept {
+    return static_cast<std::size_t>(stride_) * height_;
+  }
+  void line_horizontal(unsigned x0, unsigned x1, unsigned y, std::byte pattern, value_type const& fg,
+                       std::optional<value_type> const& bg = std::nullopt);
+  void line_vertical(unsigned x, unsigned y0, unsigned y1, value_type const& v);
+
+  /// Adds the supplied rectangle to the "dirty" area.
+  constexpr void mark_dirty(rect const& modified) noexcept {
+    dirty_ = dirty_ ? dirty_->union_rect(modified) : modified;
+  }
+
+  /// The source and destination of a transfer between bitmaps once it has been clipped.
+  struct blit_area {
+    unsigned src_x = 0U;   ///< The left-most source column
+    unsigned src_y = 0U;   ///< The top-most source row
+    unsigned dest_x = 0U;  ///< The left-most destination column
+    unsigned dest_y = 0U;  ///< The top-most destination row
+    unsigned width = 0U;   ///< The number of columns to be transferred
+    unsigned height = 0U;  ///< The number of rows to be transferred
+  };
+  /// Clips a transfer to the bounds of both the source and this bitmap.
+  ///
+  /// \param src_rect  The (inclusive) area of the source to be transferred
+  /// \param src_width  The width of the source bitmap
+  /// \param src_height  The height of the source bitmap
+  /// \param dest_pos  The position in this bitmap of the top-left corner of \p src_rect
+  /// \returns The clipped transfer or std::nullopt if nothing remains to be drawn.
+  [[nodiscard]] constexpr std::optional<blit_area> clip_blit(rect const& src_rect, std::uint16_t src_width,
+                                                             std::uint16_t src_height, point dest_pos) const noexcept;
+  /// Adds the destination of a clipped transfer to the "dirty" area.
+  constexpr void mark_dirty(blit_area const& area) noexcept {
+    this->mark_dirty({.top = static_cast<coordinate>(area.dest_y),
+                      .left = static_cast<coordinate>(area.dest_x),
+                      .bottom = static_cast<coordinate>(area.dest_y + area.height - 1U),
+                      .right = static_cast<coordinate>(area.dest_x + area.width - 1U)});
+  }
+};
+
+template <bitmap_format Format> constexpr void basic_bitmap<Format>::set(point const p, value_type const& v) {
+  if (p.x < 0 || p.y < 0) {
+    return;
+  }
+  auto const x = static_cast<unsigned>(p.x);
+  auto const y = static_cast<unsigned>(p.y);
+  if (x >= width_ || y >= height_) {
+    return;
+  }
+  assert(y * stride_ < this->actual_store_size());
+  Format::plot(&store_[y * stride_], x, v);
+  this->mark_dirty({.top = p.y, .left = p.x, .bottom = p.y, .right = p.x});
+}
+
+template <bitmap_format Format>
+constexpr auto basic_bitmap<Format>::get(point const p) const -> value_type {
+  assert(p.x >= 0 && p.x < width_ && p.y >= 0 && p.y < height_ && "point is not within the bitmap");
+  return Format::get(&store_[static_cast<std::size_t>(p.y) * stride_], static_cast<unsigned>(p.x));
+}
+
+template <bitmap_format Format>
+constexpr auto basic_bitmap<Format>::clip_blit(rect const& src_rect, std::uint16_t const src_width,
+                                               std::uint16_t const src_height, point const dest_pos) const noexcept
+    -> std::optional<blit_area> {
+  // Clip the source area to the bounds of the source, moving the destination to match.
+  auto src_left = std::max(static_cast<int>(src_rect.left), 0);
+  auto src_top = std::max(static_cast<int>(src_rect.top), 0);
+  auto src_right = std::min(static_cast<int>(src_rect.right), static_cast<int>(src_width) - 1);
+  auto src_bottom = std::min(static_cast<int>(src_rect.bottom), static_cast<int>(src_height) - 1);
+  auto dest_x = dest_pos.x + (src_left - src_rect.left);
+  auto dest_y = dest_pos.y + (src_top - src_rect.top);
+
+  // Now clip to the bounds of this bitmap.
+  if (dest_x < 0) {
+    src_left -= dest_x;
+    dest_x = 0;
+  }
+  if (dest_y < 0) {
+    src_top -= dest_y;
+    dest_y = 0;
+  }
+  src_right = std::min(src_right, src_left + static_cast<int>(width_) - 1 - dest_x);
+  src_bottom = std::min(src_bottom, src_top + static_cast<int>(height_) - 1 - dest_y);
+  if (src_left > src_right || src_top > src_bottom) {
+    return std::nullopt;
+  }
+  return blit_area{.src_x = static_cast<unsigned>(src_left),
+                   .src_y = static_cast<unsigned>(src_top),
+                   .dest_x = static_cast<unsigned>(dest_x),
+                   .dest_y = static_cast<unsigned>(dest_y),
+                   .width = static_cast<unsigned>(src_right - src_left + 1),
+                   .height = static_cast<unsigned>(src_bottom - src_top + 1)};
+}
+
+template <bitmap_format Format>
+void basic_bitmap<Format>::line_horizontal(unsigned x0, unsigned x1, unsigned const y, std::byte const pattern,
+                                           value_type const& fg, std::optional<value_type> const& bg) {
+  if (x0 > x1) {
+    std::swap(x0, x1);  // Ensure that we always go from lower to higher addresses.
+  }
+  // A gross clipping check.
+  if (x0 >= width_ || y >= height_) {
+    return;
+  }
+  // Clamp x1 to the bitmap's right edge.
+  x1 = std::min(x1, width_ - 1U);
+  assert(y * stride_ < store_.size() && "row is not within the bitmap");
+
+  this->mark_dirty({.top = static_cast<coordinate>(y),
+                    .left = static_cast<coordinate>(x0),
+                    .bottom = static_cast<coordinate>(y),
+                    .right = static_cast<coordinate>(x1)});
+  Format::span(&store_[y * stride_], x0, x1, pattern, fg, bg);
+}
+
+template <bitmap_format Format>
+void basic_bitmap<Format>::line_vertical(unsigned const x, unsigned y0, unsigned y1, value_type const& v) {
+  if (x >= width_) {
+    return;
+  }
+  if (y0 > y1) {
+    std::swap(y0, y1);
+  }
+  if (y0 >= height_) {
+    return;
+  }
+  y1 = std::min(y1 + 1U, static_cast<unsigned>(height_));
+  assert(y0 < y1);
+
+  auto index = y0 * stride_;
+  for (auto y = y0; y < y1; ++y) {
+    assert(index < store_.size() && "index is not within the bitmap");
+    Format::plot(&store_[index], x, v);
+    index += stride_;
+  }
+
+  this->mark_dirty({.top = static_cast<coordinate>(y0),
+                    .left = static_cast<coordinate>(x),
+                    .bottom = static_cast<coordinate>(y1 - 1U),
+                    .right = static_cast<coordinate>(x)});
+}
+
+template <bitmap_format Format> void basic_bitmap<Format>::line(point p0, point p1, value_type const& v) {
+  if (p0.y == p1.y) {
+    if (p0.y >= 0 && p0.y < height_) {
+      this->line_horizontal(static_cast<std::uint16_t>(std::max(p0.x, coordinate{0})),
+                            static_cast<std::uint16_t>(std::max(p1.x, coordinate{0})), static_cast<std::uint16_t>(p0.y),
+                            std::byte{0xFF}, v);
+    }
+    return;
+  }
+  if (p0.x == p1.x) {
+    if (p0.x >= 0 && p0.x < width_) {
+      this->line_vertical(static_cast<unsigned>(p0.x), static_cast<unsigned>(std::max(p0.y, coordinate{0})),
+                          static_cast<unsigned>(std::max(p1.y, coordinate{0})), v);
+    }
+    return;
+  }
+
+  auto const sx = p0.x < p1.x ? coordinate{1} : coordinate{-1};
+  auto const sy = p0.y < p1.y ? coordinate{1} : coordinate{-1};
+  auto const dx = std::abs(static_cast<int>(p1.x) - static_cast<int>(p0.x));
+  auto const dy = -std::abs(static_cast<int>(p1.y) - static_cast<int>(p0.y));
+  auto err = dx + dy;
+
+  for (;;) {
+    this->set({.x = p0.x, .y = p0.y}, v);
+    auto const e2 = err * 2;
+    if (e2 >= dy) {
+      if (p0.x == p1.x) {
+        break;
+      }
+      err += dy;
+      p0.x += sx;
+    }
+
+    if (e2 <= dx) {
+      if (p0.y == p1.y) {
+        break;
+      }
+      err += dx;
+      p0.y += sy;
+    }
+  }
+}
+
+template <bitmap_format Format> void basic_bitmap<Format>::frame_rect(rect const& r, value_type const& v) {
+  if (r.right < r.left || r.bottom < r.top) {
+    return;
+  }
+  // The top and bottom lines
+  this->line({.x = r.left, .y = r.top}, {.x = r.right, .y = r.top}, v);
+  this->line({.x = r.left, .y = r.bottom}, {.x = r.right, .y = r.bottom}, v);
+  // The left and right lines
+  this->line({.x = r.left, .y = r.top}, {.x = r.left, .y = r.bottom}, v);
+  this->line({.x = r.right, .y = r.top}, {.x = r.right, .y = r.bottom}, v);
+}
+
+template <bitmap_format Format>
+void basic_bitmap<Format>::paint_rect(rect const& r, pattern const& pat, value_type const& fg,
+                                      std::optional<value_type> const& bg) {
+  if (r.bottom < r.top || r.right < r.left || r.bottom < 0 || r.right < 0) {
+    return;
+  }
+  if ((r.top >= 0 && static_cast<unsigned>(r.top) >= height_) ||
+      (r.left >= 0 && static_cast<unsigned>(r.left) >= width_)) {
+    return;
+  }
+  auto const x0 = static_cast<unsigned>(std::max(r.left, coordinate{0}));
+  auto const x1 = std::min(static_cast<unsigned>(r.right), width_ - 1U);
+  auto const y0 = static_cast<unsigned>(std::max(r.top, coordinate{0}));
+  auto const y1 = std::min(static_cast<unsigned>(r.bottom), height_ - 1U);
+  for (auto y = y0; y <= y1; ++y) {
+    assert(y * stride_ < store_.size() && "row is not within the bitmap");
+    Format::span(&store_[y * stride_], x0, x1, pat.data[y % 8U], fg, bg);
+  }
+
+  this->mark_dirty({.top = static_cast<coordinate>(y0),
+                    .left = static_cast<coordinate>(x0),
+                    .bottom = static_cast<coordinate>(y1),
+                    .right = static_cast<coordinate>(x1)});
+}
+
+using rgb565_bitmap = basic_bitmap<rgb565_format>;
+
+}  // end namespace draw
+
+#endif  // DRAW_BASIC_BITMAP_HPP
@@ -41,6 +41,7 @@
 #include <ranges>
 #include <span>
 
+#include "draw/basic_bitmap.hpp"
 #include "draw/types.hpp"
 
 #ifndef DRAW_HOSTED
@@ -49,51 +50,52 @@
 
 namespace draw {
 
+class bitmap32;
 struct font;
-class glyph_cache;
+class glyph_source;
 
-class bitmap {
-  friend class glyph_cache;
+class bitmap : public basic_bitmap<mono_format> {
+  friend class glyph_source;
 
 public:
-  constexpr bitmap() noexcept = default;
-  constexpr bitmap(std::span<std::byte> const& store, std::uint16_t const width, std::uint16_t const height,
-                   std::uint16_t const stride) noexcept
-      : width_{width}, height_{height}, stride_{stride}, store_{store} {
-    assert(store.size() >= this->actual_store_size() && "store is too small");
-    assert(width <= static_cast<std::uint16_t>(std::numeric_limits<coordinate>::max()) && "width is too great");
-    assert(height <= static_cast<std::uint16_t>(std::numeric_limits<coordinate>::max()) && "height is too great");
-  }
-  constexpr bitmap(std::span<std::byte> const& store, std::uint16_t const width, std::uint16_t const height) noexcept
-      : bitmap(store, width, height, required_stride(width)) {}
-
-  [[nodiscard]] static constexpr std::uint16_t required_stride(std::uint16_t const width) noexcept {
-    assert(width <= static_cast<std::uint16_t>(std::numeric_limits<coordinate>::max()) && "width is too great");
-    return static_cast<std::uint16_t>((width + 7U) / 8U);
-  }
-  /// Returns the store size required for a bitmap with the supplied dimensions.
-  /// \param width  The desired width of the bitmap in pixels.
-  /// \param height  The desired height of the bitmap in pixels.
-  /// \returns The size, in bytes, of the required frame store for a bitmap with the supplied dimensions.
-  [[nodiscard]] static constexpr std::size_t required_store_size(std::uint16_t width, std::uint16_t height) noexcept {
-    assert(height <= static_cast<std::uint16_t>(std::numeric_limits<coordinate>::max()) && "height is too great");
-    return required_stride(width) * static_cast<std::size_t>(height);
-  }
+  using basic_bitmap::basic_bitmap;
 
   enum class transfer_mode : std::uint8_t { mode_copy, mode_or };
   void copy(bitmap const& source, point dest_pos, transfer_mode mode);
-  void clear() { std::ranges::fill(this->store(), std::byte{0U}); }
   /// Sets or clears an individual pixel.
   /// \param p The pixel to be set
   /// \param new_state The desired state of the pixel
-  constexpr void set(point p, bool new_state);
+  constexpr void set(point const p, bool const new_state) { basic_bitmap::set(p, static_cast<value_type>(new_state)); }
   /// Draws a straight line from p0 to p1.
   /// \param p0  Coordinate of one end of the line
   /// \param p1  Coordinate of the other end of the line
-  void line(point p0, point p1);
-
-  void frame_rect(rect const& r);
-  void paint_rect(rect const& r, pattern const& pat);
+  void line(point const p0, point const p1) { basic_bitmap::line(p0, p1, value_type{1}); }
+
+  void frame_rect(rect const& r) { basic_bitmap::frame_rect(r, value_type{1}); }
+  /// Fills a rectangle with a pattern. Pixels corresponding to set bits in the pattern are set and the remainder
+  /// cleared.
+  void paint_rect(rect const& r, pattern const& pat) { basic_bitmap::paint_rect(r, pat, value_type{1}, value_type{0}); }
+
+  /// The methods by which a bitmap32 may be reduced to one bit per pixel.
+  enum class dither_mode : std::uint8_t {
+    bayer4,           ///< Ordered dither using a 4x4 Bayer matrix
+    bayer8,           ///< Ordered dither using an 8x8 Bayer matrix
+    floyd_steinberg,  ///< Error diffusion using the Floyd-Steinberg weights
+    atkinson,         ///< Error diffusion using Atkinson's weights (which lose 1/4 of the error)
+  };
+  /// Returns the number of error buffer entries needed to dither an area of the given width using error diffusion.
+  [[nodiscard]] static constexpr std::size_t dither_errors_size(std::uint16_t const width) noexcept {
+    return 2U * static_cast<std::size_t>(width);
+  }
+  /// Reduces an area of a bitmap32 to this bitmap. The source pixels are treated as if composited over white so that
+  /// transparent areas produce clear pixels; dark pixels are set.
+  ///
+  /// \param source  The bitmap to be dithered. It is read at the same coordinates as are written in this bitmap.
+  /// \param r  The (inclusive) area to be converted. It is clipped to the bounds of both bitmaps.
+  /// \param mode  The dithering method to be used
+  /// \param errors  A buffer for the error diffusion methods of at least dither_errors_size(r.right - r.left + 1)
+  ///   entries. It is unused by the ordered methods.
+  void dither(bitmap32 const& source, rect const& r, dither_mode mode, std::span<std::int16_t> errors = {});
 
   /// Renders an individual glyph.
   ///
@@ -101,13 +103,13 @@ public:
   /// \param f  The font in which the character will be rendered
   /// \param code_point  The code point specifying the glyph to be drawn
   /// \param pos The position at which the glyph should be drawn
-  void draw_char(glyph_cache& gc, font const& f, char32_t code_point, point pos);
+  void draw_char(glyph_source& gc, font const& f, char32_t code_point, point pos);
   /// \param gc  The glyph cache
   /// \param f  The font in which the character will be rendered
   /// \param s  The UTF-8 encoded string to be drawn
   /// \param pos  The position for the first of the run of glyphs
   /// \returns  The origin position \p pos with the x coordinate increased by the width of all the rendered glyphs.
-  point draw_string(glyph_cache& gc, font const& f, std::u8string_view s, point pos);
+  point draw_string(glyph_source& gc, font const& f, std::u8string_view s, point pos);
   /// Returns the character width of the specified character.
   ///
   /// \param f  A font instance
@@ -115,72 +117,11 @@ public:
   /// \returns The width of the specified glyph
   [[nodiscard]] static std::uint16_t char_width(font const& f, char32_t code_point);
 
-  [[nodiscard]] constexpr std::uint16_t width() const noexcept { return width_; }
-  [[nodiscard]] constexpr std::uint16_t height() const noexcept { return height_; }
-  [[nodiscard]] constexpr std::uint16_t stride() const noexcept { return stride_; }
-  [[nodiscard]] constexpr rect bounds() const noexcept {
-    return {.top = 0,
-            .left = 0,
-            .bottom = static_cast<coordinate>(height() - 1U),
-            .right = static_cast<coordinate>(width() - 1U)};
-  }
-  [[nodiscard]] constexpr std::optional<rect> const& dirty() const noexcept { return dirty_; }
-  constexpr void clean() noexcept { dirty_.reset(); }
-
-  [[nodiscard]] constexpr std::span<std::byte const> store() const noexcept { return store_; }
-  [[nodiscard]] constexpr std::span<std::byte> store() noexcept { return store_; }
-
 #if defined(DRAW_HOSTED) && DRAW_HOSTED
   void dump(std::FILE* stream = stdout) const;
 #endif
-
-private:
-  std::uint16_t width_ = 0U;    ///< Width of the bitmap in pixels
-  std::uint16_t height_ = 0U;   ///< Height of the bitmap in pixels
-  std::uint16_t stride_ = 0U;   ///< Number of bytes per row
-  std::span<std::byte> store_;  ///< The backing store containing the bitmap's pixel data
-  std::optional<rect> dirty_;   ///< The area of the bitmap modified since the last call to clean(), if any.
-
-  [[nodiscard]] constexpr std::size_t actual_store_size() const noexcept {
-    return static_cast<std::size_t>(stride_) * height_;
-  }
-  void line_horizontal(unsigned x0, unsigned x1, unsigned y, std::byte pattern);
-  void line_vertical(unsigned x, unsigned y0, unsigned y1);
-
-  /// Adds the supplied rectangle to the "dirty" area.
-  constexpr void mark_dirty(rect const& modified) noexcept {
-    dirty_ = dirty_ ? dirty_->union_rect(modified) : modified;
-  }
 };
 
-constexpr void bitmap::set(point const p, bool const new_state) {
-  if (p.x < 0 || p.y < 0) {
-    return;
-  }
-  auto const x = static_cast<unsigned>(p.x);
-  auto const y = static_cast<unsigned>(p.y);
-  if (x >= width_ || y >= height_) {
-    return;
-  }
-  auto const index = y * stride_ + x / 8U;
-  assert(index < this->actual_store_size());
-  auto& b = store_[index];
-  auto const bit = std::byte{0x80U} >> (x % 8U);
-  // TODO: Checkout <https://graphics.stanford.edu/~seander/bithacks.html#ConditionalSetOrClearBitsWithoutBranching>
-  if (new_state) {
-    b |= bit;
-  } else {
-    b &= ~bit;
-  }
-
-  this->mark_dirty({.top = p.y, .left = p.x, .bottom = p.y, .right = p.x});
-}
-
-extern pattern const black;
-extern pattern const white;
-extern pattern const gray;
-extern pattern const light_gray;
-
 }  // end namespace draw
 
 #endif  // DRAW_BITMAP_HPP
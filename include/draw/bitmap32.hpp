@@ -38,9 +38,12 @@
 #include <cstdlib>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <span>
 
+#include "draw/alpha8.hpp"
+#include "draw/basic_bitmap.hpp"
 #include "draw/types.hpp"
 
 #ifndef DRAW_HOSTED
@@ -49,70 +52,235 @@
 
 namespace draw {
 
+class bitmap;
 struct font;
-class glyph_cache;
+class glyph_source;
 
-class bitmap32 {
-  friend class glyph_cache;
+class bitmap32 : public basic_bitmap<rgba_premult_format> {
+  friend class glyph_source;
+  /// The number of box filter passes used by drop_shadow().
+  static constexpr auto shadow_passes = 3U;
 
 public:
-  constexpr bitmap32() noexcept = default;
-  constexpr bitmap32(std::span<rgba_premult> const& store, std::uint16_t const width, std::uint16_t const height,
-                     std::uint16_t const stride) noexcept
-      : width_{width}, height_{height}, stride_{stride}, store_{store} {
-    assert(store.size() >= this->actual_store_size() && "store is too small");
-    assert(width <= static_cast<std::uint16_t>(std::numeric_limits<coordinate>::max()) && "width is too great");
-    assert(height <= static_cast<std::uint16_t>(std::numeric_limits<coordinate>::max()) && "height is too great");
-  }
-  constexpr bitmap32(std::span<rgba_premult> const& store, std::uint16_t const width,
-                     std::uint16_t const height) noexcept
-      : bitmap32(store, width, height, required_stride(width)) {}
+  using basic_bitmap::basic_bitmap;
 
-  [[nodiscard]] static constexpr std::uint16_t required_stride(std::uint16_t const width) noexcept {
-    assert(width <= static_cast<std::uint16_t>(std::numeric_limits<coordinate>::max()) && "width is too great");
-    return width;
-  }
-  /// Returns the store size required for a bitmap with the supplied dimensions.
-  /// \param width  The desired width of the bitmap in pixels.
-  /// \param height  The desired height of the bitmap in pixels.
-  /// \returns The size, in bytes, of the required frame store for a bitmap with the supplied dimensions.
-  [[nodiscard]] static constexpr std::size_t required_store_size(std::uint16_t const width,
-                                                                 std::uint16_t const height) noexcept {
-    assert(height <= static_cast<std::uint16_t>(std::numeric_limits<coordinate>::max()) && "height is too great");
-    return required_stride(width) * static_cast<std::size_t>(height);
-  }
-  [[nodiscard]] constexpr std::span<rgba_premult const> store() const noexcept { return store_; }
-  [[nodiscard]] constexpr std::span<rgba_premult> store() noexcept { return store_; }
-
-  enum class transfer_mode : std::uint8_t { mode_copy, mode_or };
+  /// The operators used to combine source and destination pixels. These are the Porter-Duff compositing operators
+  /// followed by the separable blend modes, all of which work on premultiplied colors.
+  enum class transfer_mode : std::uint8_t {
+    mode_clear,     ///< Both color and alpha are cleared
+    mode_src,       ///< The source replaces the destination
+    mode_src_over,  ///< The source is placed over the destination
+    mode_dst_over,  ///< The destination is placed over the source
+    mode_src_in,    ///< The part of the source lying inside of the destination replaces the destination
+    mode_dst_out,   ///< The part of the destination lying outside of the source replaces the destination
+    mode_xor,       ///< The parts of the source and destination lying outside of each other are combined
+    mode_multiply,  ///< The source and destination colors are multiplied
+    mode_screen,    ///< The complements of the source and destination are multiplied and then complemented
+    mode_darken,    ///< Selects the darker of the source and destination colors
+    mode_lighten,   ///< Selects the lighter of the source and destination colors
+    /// The source is placed over the destination with the blending performed in linear light rather than sRGB. This
+    /// avoids the darkening of anti-aliased edges and translucent gradients at the cost of table lookups per channel.
+    mode_src_over_linear,
+  };
+  /// Combines the pixels of \p source with those of this bitmap using the operator given by \p mode.
+  ///
+  /// \param source  The bitmap to be copied
+  /// \param dest_pos  The position in this bitmap of the top-left corner of \p source
+  /// \param mode  The operator used to combine the source and destination pixels
   void copy(bitmap32 const& source, point dest_pos, transfer_mode mode);
-  void clear() { std::ranges::fill(this->store(), rgba_premult{}); }
-  /// Sets or clears an individual pixel.
+  /// Copies \p source to this bitmap treating pixels of the key color as transparent: they leave the destination
+  /// unchanged while all other pixels replace it. This allows sprites prepared with a key color (such as magenta)
+  /// rather than alpha to be drawn without conversion.
+  ///
+  /// \param source  The bitmap to be copied
+  /// \param dest_pos  The position in this bitmap of the top-left corner of \p source
+  /// \param key  The color of the source's transparent pixels
+  void copy_keyed(bitmap32 const& source, point dest_pos, rgba const& key);
+
+  /// The filters with which copy_scaled() may resample its source.
+  enum class scale_filter : std::uint8_t {
+    nearest,   ///< Each destination pixel takes the value of the source pixel nearest to its center
+    bilinear,  ///< Each destination pixel is interpolated from the four source pixels nearest to its center
+  };
+  /// Scales the whole of \p source to fill a rectangle of this bitmap. The rectangle may extend beyond the bitmap in
+  /// which case the scaled image is clipped.
+  ///
+  /// \param source  The bitmap to be scaled
+  /// \param dest_rect  The (inclusive) area of this bitmap to be covered by \p source
+  /// \param filter  The resampling filter
+  /// \param mode  The operator used to combine the scaled pixels with those of this bitmap
+  void copy_scaled(bitmap32 const& source, rect const& dest_rect, scale_filter filter,
+                   transfer_mode mode = transfer_mode::mode_src);
+
+  /// The shapes of gradient that may be painted by paint_gradient().
+  enum class gradient_kind : std::uint8_t {
+    linear,  ///< The color varies along the line from the start point to the end point
+    radial,  ///< The color varies with distance from the start point; the end point lies on the outermost circle
+  };
+  /// A color at a position along a gradient.
+  struct gradient_stop {
+    std::uint8_t position = 0U;  ///< The position of the stop from 0 (the start point) to 255 (the end point)
+    rgba color;                  ///< The color at this position
+  };
+  /// Fills a rectangle with a gradient. The colors of the stops are interpolated to give a ramp of 256 colors
+  /// before painting; positions before the first stop or after the last take the color of that stop.
+  ///
+  /// \param r  The (inclusive) area to be painted
+  /// \param stops  The colors of the gradient in ascending order of position. There must be at least one stop.
+  /// \param kind  The shape of the gradient
+  /// \param start  The position of the first color of the ramp: the start of a linear gradient or the center of a
+  ///   radial gradient
+  /// \param end  The position of the last color of the ramp
+  /// \param mode  The operator used to combine the gradient with the pixels of this bitmap
+  void paint_gradient(rect const& r, std::span<gradient_stop const> stops, gradient_kind kind, point start, point end,
+                      transfer_mode mode = transfer_mode::mode_src_over);
+  /// Expands an area of a 1bpp bitmap into this bitmap. Set pixels become \p fg and clear pixels become \p bg; the
+  /// original contents of the destination are replaced.
+  ///
+  /// \param source  The 1bpp bitmap to be expanded
+  /// \param src_rect  The (inclusive) area of \p source to be expanded
+  /// \param dest_pos  The position in this bitmap of the top-left corner of \p src_rect
+  /// \param fg  The color of set pixels
+  /// \param bg  The color of clear pixels
+  void expand(bitmap const& source, rect const& src_rect, point dest_pos, rgba const& fg, rgba const& bg);
+  /// Composites \p fg over this bitmap wherever a pixel is set in an area of a 1bpp bitmap. Pixels corresponding to
+  /// clear pixels are left unchanged.
+  ///
+  /// \param source  The 1bpp bitmap to be expanded
+  /// \param src_rect  The (inclusive) area of \p source to be expanded
+  /// \param dest_pos  The position in this bitmap of the top-left corner of \p src_rect
+  /// \param fg  The color of set pixels
+  void expand(bitmap const& source, rect const& src_rect, point dest_pos, rgba const& fg);
+  /// Composites a solid color over this bitmap with the coverage given by a mask: each pixel receives the color
+  /// scaled by the corresponding mask value.
+  ///
+  /// \param mask  The coverage of each pixel
+  /// \param dest_pos  The position in this bitmap of the top-left corner of \p mask
+  /// \param color  The color to be applied
+  void fill_mask(alpha8 const& mask, point dest_pos, rgba const& color);
+  /// Blurs an area of the bitmap by applying a box filter horizontally and then vertically to each channel. Each pass
+  /// costs the same regardless of radius; three passes closely approximate a gaussian. Values beyond the edges of \p r
+  /// are taken to be those of the nearest pixel inside it; pixels outside of \p r are neither read nor modified.
+  ///
+  /// \param r  The (inclusive) area to be blurred
+  /// \param radius  The number of pixels either side of each pixel that contribute to its value. Must not exceed
+  ///   max_blur_radius.
+  /// \param passes  The number of times that the box filter is applied
+  void box_blur(rect const& r, unsigned radius, unsigned passes = 3U);
+  /// \returns The distance by which a shadow drawn by drop_shadow() extends beyond each edge of its layer.
+  [[nodiscard]] static constexpr unsigned shadow_margin(unsigned const radius) noexcept {
+    return radius * shadow_passes;
+  }
+  /// Composites \p layer over this bitmap with a soft shadow beneath it. The shadow is the alpha of the layer blurred
+  /// with three box filter passes and applied in \p color.
+  ///
+  /// \param layer  The bitmap casting the shadow
+  /// \param dest_pos  The position in this bitmap of the top-left corner of \p layer
+  /// \param offset  The displacement of the shadow relative to \p layer
+  /// \param radius  The radius of each blur pass. Must not exceed max_blur_radius.
+  /// \param color  The color of the shadow. Its alpha gives the opacity beneath fully opaque parts of the layer.
+  /// \param scratch  A mask in which the shadow is built. It must be at least 2 * shadow_margin(radius) pixels wider
+  ///   and taller than \p layer. Its contents are overwritten.
+  void drop_shadow(bitmap32 const& layer, point dest_pos, point offset, unsigned radius, rgba const& color,
+                   alpha8& scratch);
+  using basic_bitmap::frame_rect;
+  using basic_bitmap::line;
+  using basic_bitmap::paint_rect;
+  using basic_bitmap::set;
+  /// Composites a color over an individual pixel.
   /// \param p The pixel to be set
-  /// \param color The desired color of the pixel
-  constexpr void set(point const p, rgba const& color);
-  constexpr void set(point const p, rgba_premult const& color);
+  /// \param color The color to be composited
+  constexpr void set(point const p, rgba const& color) { basic_bitmap::set(p, rgba_premult{color}); }
   /// Draws a straight line from p0 to p1.
   /// \param p0  Coordinate of one end of the line
   /// \param p1  Coordinate of the other end of the line
-  void line(point p0, point p1, rgba const& color);
+  /// \param color  The color of the line
+  void line(point const p0, point const p1, rgba const& color) { basic_bitmap::line(p0, p1, rgba_premult{color}); }
+  /// Draws an anti-aliased line from p0 to p1 using Wu's algorithm. Each step along the major axis composites the
+  /// color over the two pixels straddling the line, scaled by their integer coverage. Horizontal, vertical, and
+  /// diagonal lines cover whole pixels and are drawn as by line().
+  ///
+  /// \param p0  Coordinate of one end of the line
+  /// \param p1  Coordinate of the other end of the line
+  /// \param color  The color of the line
+  void line_aa(point p0, point p1, rgba const& color);
+  /// Draws the outline of a rectangle.
+  /// \param r  The rectangle to be drawn
+  /// \param color  The color of the outline
+  void frame_rect(rect const& r, rgba const& color) { basic_bitmap::frame_rect(r, rgba_premult{color}); }
 
-  void frame_rect(rect const& r);
-  void paint_rect(rect const& r, pattern const& pat);
+  /// How the ends of an open stroke are drawn.
+  enum class line_cap : std::uint8_t {
+    butt,    ///< The stroke ends at the end point
+    square,  ///< The stroke extends beyond the end point by half of its width
+    round,   ///< The stroke ends with a semicircle centered on the end point
+  };
+  /// How the corners between the segments of a stroke are drawn.
+  enum class line_join : std::uint8_t {
+    miter,  ///< The outer edges are extended until they meet. Corners sharper than about 29 degrees are beveled.
+    bevel,  ///< The outer corners of the segments are joined by a straight edge
+    round,  ///< The corner is rounded with a circle centered on the vertex
+  };
+  /// The appearance of a stroke.
+  struct stroke_style {
+    std::uint16_t width = 1U;           ///< The width of the stroke in pixels
+    line_cap cap = line_cap::butt;      ///< The shape of the ends of an open stroke
+    line_join join = line_join::miter;  ///< The shape of the corners between segments
+  };
+  /// Strokes a sequence of connected line segments. The segments, joins, and caps are converted to a single run of
+  /// pixels on each row so that every pixel is painted exactly once even where the parts of the stroke overlap: a
+  /// translucent stroke has a uniform color.
+  ///
+  /// \param points  The vertices of the stroke. The stroke's center-line passes through the center of each.
+  /// \param style  The width, caps, and joins of the stroke
+  /// \param color  The color of the stroke
+  /// \param closed  If true, the last point is joined to the first and the stroke has no caps
+  void stroke_polyline(std::span<point const> points, stroke_style const& style, rgba const& color,
+                       bool closed = false);
+  /// Strokes a straight line from p0 to p1.
+  /// \param p0  Coordinate of one end of the line
+  /// \param p1  Coordinate of the other end of the line
+  /// \param style  The width and caps of the line
+  /// \param color  The color of the line
+  void stroke_line(point const p0, point const p1, stroke_style const& style, rgba const& color) {
+    std::array const points{p0, p1};
+    this->stroke_polyline(points, style, color);
+  }
+  /// Strokes the outline of a rectangle. The stroke is centered on the rectangle's edges.
+  /// \param r  The rectangle to be drawn
+  /// \param style  The width and joins of the outline
+  /// \param color  The color of the outline
+  void stroke_rect(rect const& r, stroke_style const& style, rgba const& color) {
+    std::array const points{r.top_left(), point{.x = r.right, .y = r.top}, r.bot_right(),
+                            point{.x = r.left, .y = r.bottom}};
+    this->stroke_polyline(points, style, color, true);
+  }
+  /// Fills a rectangle with a pattern. Pixels corresponding to set bits in the pattern are composited with \p color;
+  /// the remainder are left unchanged. The pattern bit order matches that of the 1bpp bitmap.
+  ///
+  /// \param r  The rectangle to be filled
+  /// \param pat  The pattern with which the rectangle is to be filled
+  /// \param color  The color of the pixels corresponding to set bits in the pattern
+  void paint_rect(rect const& r, pattern const& pat, rgba const& color) {
+    basic_bitmap::paint_rect(r, pat, rgba_premult{color});
+  }
 
-  /// Renders an individual glyph.
+  /// Renders an individual glyph. The glyph's 1bpp bitmap is composited directly into this bitmap in the requested
+  /// color without an intermediate 32-bit copy.
   ///
   /// \param gc  The glyph cache
   /// \param f  The font in which the character will be rendered
   /// \param code_point  The code point specifying the glyph to be drawn
   /// \param pos The position at which the glyph should be drawn
-  void draw_char(glyph_cache& gc, font const& f, char32_t code_point, point pos);
+  /// \param color  The color in which the glyph will be drawn
+  void draw_char(glyph_source& gc, font const& f, char32_t code_point, point pos, rgba const& color);
   /// \param gc  The glyph cache
   /// \param f  The font in which the character will be rendered
   /// \param s  The UTF-8 encoded string to be drawn
   /// \param pos  The position for the first of the run of glyphs
+  /// \param color  The color in which the glyphs will be drawn
   /// \returns  The origin position \p pos with the x coordinate increased by the width of all the rendered glyphs.
-  point draw_string(glyph_cache& gc, font const& f, std::u8string_view s, point pos);
+  point draw_string(glyph_source& gc, font const& f, std::u8string_view s, point pos, rgba const& color);
   /// Returns the character width of the specified character.
   ///
   /// \param f  A font instance
@@ -120,60 +288,17 @@ public:
   /// \returns The width of the specified glyph
   [[nodiscard]] static std::uint16_t char_width(font const& f, char32_t code_point);
 
-  [[nodiscard]] constexpr std::uint16_t width() const noexcept { return width_; }
-  [[nodiscard]] constexpr std::uint16_t height() const noexcept { return height_; }
-  [[nodiscard]] constexpr std::uint16_t stride() const noexcept { return stride_; }
-  [[nodiscard]] constexpr rect bounds() const noexcept {
-    return {.top = 0,
-            .left = 0,
-            .bottom = static_cast<coordinate>(height() - 1U),
-            .right = static_cast<coordinate>(width() - 1U)};
-  }
-  [[nodiscard]] constexpr std::optional<rect> const& dirty() const noexcept { return dirty_; }
-  constexpr void clean() noexcept { dirty_.reset(); }
-
 #if defined(DRAW_HOSTED) && DRAW_HOSTED
   void dump(std::FILE* stream = stdout) const;
 #endif
 
 private:
-  std::uint16_t width_ = 0U;       ///< Width of the bitmap in pixels
-  std::uint16_t height_ = 0U;      ///< Height of the bitmap in pixels
-  std::uint16_t stride_ = 0U;      ///< Number of bytes per row
-  std::optional<rect> dirty_;      ///< The area of the bitmap modified since the last call to clean(), if any.
-  std::span<rgba_premult> store_;  ///< The backing store containing the bitmap's pixel data
-
-  [[nodiscard]] constexpr std::size_t actual_store_size() const noexcept {
-    return static_cast<std::size_t>(stride_) * height_;
-  }
-  // void line_horizontal(unsigned x0, unsigned x1, unsigned y, std::byte pattern);
-  void line_horizontal(unsigned x0, unsigned x1, unsigned const y, rgba_premult const& color, std::byte const pattern);
-  void line_vertical(unsigned const x, unsigned y0, unsigned y1, rgba_premult const& color);
-
-  /// Adds the supplied rectangle to the "dirty" area.
-  constexpr void mark_dirty(rect const& modified) noexcept {
-    dirty_ = dirty_ ? dirty_->union_rect(modified) : modified;
-  }
+  /// Expands the area \p src_rect of the 1bpp bitmap \p mask placed at \p dest_pos. Set pixels are composited with
+  /// \p fg; clear pixels are replaced by \p bg if it has a value and are otherwise left unchanged.
+  void expand_mask(bitmap const& mask, rect const& src_rect, point dest_pos, rgba_premult const& fg,
+                   std::optional<rgba_premult> const& bg);
 };
 
-constexpr void bitmap32::set(point const p, rgba_premult const& color) {
-  if (p.x < 0 || p.y < 0) {
-    return;
-  }
-  auto const x = static_cast<unsigned>(p.x);
-  auto const y = static_cast<unsigned>(p.y);
-  if (x >= width_ || y >= height_) {
-    return;
-  }
-  auto const index = y * stride_ + x;
-  assert(index < this->actual_store_size());
-  store_[index].composite(color);
-  this->mark_dirty({.top = p.y, .left = p.x, .bottom = p.y, .right = p.x});
-}
-constexpr void bitmap32::set(point const p, rgba const& color) {
-  this->set(p, rgba_premult{color});
-}
-
 }  // end namespace draw
 
 #endif  // DRAW_BITMAP32_HPP
@@ -0,0 +1,107 @@
+//===- include/draw/convert.hpp ---------------------------*- mode: C++ -*-===//
+//*                                _    *
+//*   ___ ___  _ ____   _____ _ __| |_  *
+//*  / __/ _ \| '_ \ \ / / _ \ '__| __| *
+//* | (_| (_) | | | \ V /  __/ |  | |_  *
+//*  \___\___/|_| |_|\_/ \___|_|   \__| *
+//*                                     *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+#ifndef DRAW_CONVERT_HPP
+#define DRAW_CONVERT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "draw/types.hpp"
+
+namespace draw {
+
+class bitmap32;
+class indexed8_bitmap;
+
+/// The pixel formats into which the contents of a bitmap32 can be converted for transmission to a display panel.
+enum class pixel_format : std::uint8_t {
+  rgb565,    ///< 16 bits per pixel, most significant byte first
+  rgb888,    ///< 24 bits per pixel, red first
+  bgr888,    ///< 24 bits per pixel, blue first
+  gray8,     ///< 8 bits of luminance per pixel
+  rgba8888,  ///< 32 bits per pixel with straight (non-premultiplied) alpha
+};
+
+/// \returns The number of bytes occupied by a single pixel of the given format.
+[[nodiscard]] constexpr std::size_t bytes_per_pixel(pixel_format const format) noexcept {
+  switch (format) {
+  case pixel_format::rgb565: return 2;
+  case pixel_format::rgb888:
+  case pixel_format::bgr888: return 3;
+  case pixel_format::gray8: return 1;
+  case pixel_format::rgba8888: return 4;
+  }
+  return 0;
+}
+
+/// Converts the pixels of \p source that lie within \p area to \p format. The converted rows are written one after
+/// another with no padding to the buffer supplied by the caller so no memory is allocated.
+///
+/// The formats with no alpha channel show the bitmap as if it were composited over black: this requires no division
+/// and is what a panel displays for a translucent pixel. rgba8888 produces straight alpha.
+///
+/// \param source  The bitmap whose pixels are to be converted.
+/// \param area  The (inclusive) area of the bitmap to be converted: typically its dirty rectangle. It is clipped to
+///   the bitmap's bounds.
+/// \param format  The pixel format to be produced.
+/// \param dest  The buffer to which the converted pixels are written. It must be large enough to hold the clipped
+///   area.
+/// \returns  The portion of \p dest that holds the converted pixels.
+std::span<std::byte> convert(bitmap32 const& source, rect const& area, pixel_format format,
+                             std::span<std::byte> dest) noexcept;
+
+/// \returns The RGB565 value of \p c as it appears when composited over black. This matches the conversion of a
+///   bitmap32 to pixel_format::rgb565.
+[[nodiscard]] constexpr std::uint16_t to_rgb565(rgba_premult const& c) noexcept {
+  return static_cast<std::uint16_t>(((c.r & 0xF8U) << 8U) | ((c.g & 0xFCU) << 3U) | (c.b >> 3U));
+}
+
+/// A color lookup table which maps each index of an indexed8_bitmap to an RGB565 value.
+using clut565 = std::span<std::uint16_t const, 256>;
+
+/// Expands the palette indices of \p source that lie within \p area to RGB565 using a color lookup table. The
+/// result is written most significant byte first with no padding between rows, as convert() does for a bitmap32
+/// with pixel_format::rgb565.
+///
+/// \param source  The bitmap whose pixels are to be converted.
+/// \param area  The (inclusive) area of the bitmap to be converted: typically its dirty rectangle. It is clipped to
+///   the bitmap's bounds.
+/// \param clut  The RGB565 value of each palette index.
+/// \param dest  The buffer to which the converted pixels are written. It must be large enough to hold the clipped
+///   area.
+/// \returns  The portion of \p dest that holds the converted pixels.
+std::span<std::byte> convert(indexed8_bitmap const& source, rect const& area, clut565 clut,
+                             std::span<std::byte> dest) noexcept;
+
+}  // end namespace draw
+
+#endif  // DRAW_CONVERT_HPP
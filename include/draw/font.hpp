@@ -117,9 +117,21 @@ struct trivial_span {
 static_assert(std::is_trivial_v<trivial_span<int>>,
               "The trivial_span<> type must be trivial so that glyph_map can be constexpr");
 
+/// The arrangement of the bitmap data of a font's glyphs.
+enum class glyph_layout : std::uint8_t {
+  /// Groups of bytes each representing a column of pixels (see font).
+  column_major,
+  /// Rows of pixels with each row padded to a whole number of bytes. This is the layout used by draw::bitmap so
+  /// glyphs can be drawn directly from the font data.
+  row_major,
+};
+
 struct glyph {
   trivial_span<kerning_pair const> kerns;
   trivial_span<std::byte const> bm;
+  /// The width of the glyph in pixels. Used only by row-major fonts: the width of a column-major glyph follows from
+  /// the size of its bitmap data.
+  std::uint8_t width;
 };
 static_assert(std::is_trivial_v<glyph>, "The glyph type must be trivial so that glyph_map can be constexpr");
 
@@ -129,6 +141,9 @@ static_assert(std::is_trivial_v<glyph>, "The glyph type must be trivial so that
 // groups of 4 bytes give a total of 32 pixels per group. Each group of bytes represents a single
 // column of pixels in the font. The least significant bit in each byte holds the pixel value for
 // the smallest y position.
+//
+// Fonts with a 'layout' of glyph_layout::row_major instead store each glyph as rows of pixels in the same order as
+// draw::bitmap.
 struct font {
   // NOLINTBEGIN(misc-non-private-member-variables-in-classes)
   std::uint8_t id = 0U;  ///< A unique ID for the font
@@ -136,12 +151,16 @@ struct font {
   std::uint8_t widest = 0U;      ///< The width in pixels of the widest glyph in the font.
   std::uint8_t height : 4 = 0U;  ///< Height of a glyph (measured in bytes rather than pixels).
   std::uint8_t spacing : 4 = 0U;  ///< The default number of pixels between glyphs (before kerning adjustment).
+  glyph_layout layout = glyph_layout::column_major;  ///< The arrangement of the glyph bitmap data.
 
   using glyph_map = iumap<std::uint32_t, glyph, 256U, details::glyph_hasher>;
   glyph_map glyphs;
   // NOLINTEND(misc-non-private-member-variables-in-classes)
 
   [[nodiscard]] constexpr std::uint16_t width(glyph const& g) const noexcept {
+    if (layout == glyph_layout::row_major) {
+      return g.width;
+    }
     auto const& bitmap = g.bm;
     return static_cast<std::uint16_t>(bitmap.size() / this->height);
   }
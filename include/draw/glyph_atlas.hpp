@@ -0,0 +1,177 @@
+//===- include/draw/glyph_atlas.hpp -----------------------*- mode: C++ -*-===//
+//*        _             _             _   _            *
+//*   __ _| |_   _ _ __ | |__     __ _| |_| | __ _ ___  *
+//*  / _` | | | | | '_ \| '_ \   / _` | __| |/ _` / __| *
+//* | (_| | | |_| | |_) | | | | | (_| | |_| | (_| \__ \ *
+//*  \__, |_|\__, | .__/|_| |_|  \__,_|\__|_|\__,_|___/ *
+//*  |___/   |___/|_|                                   *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+#ifndef DRAW_GLYPH_ATLAS_HPP
+#define DRAW_GLYPH_ATLAS_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "draw/bitmap.hpp"
+#include "draw/font.hpp"
+#include "draw/glyph_cache.hpp"
+
+namespace draw {
+
+namespace details {
+
+/// Associates a code point with the atlas image holding its glyph.
+struct atlas_entry {
+  char32_t code_point = 0U;
+  std::uint16_t image = 0U;
+};
+
+/// Describes the placement of every glyph in a font's atlas. This is used only during constant evaluation.
+template <std::size_t GlyphCount> struct atlas_layout {
+  struct image {
+    trivial_span<std::byte const> source;  ///< The glyph's bitmap data as stored in the font.
+    std::uint16_t width = 0U;
+    std::size_t offset = 0U;  ///< The index of the image's first byte within the atlas pixel store.
+  };
+  /// The font's code points in ascending order.
+  std::array<atlas_entry, GlyphCount> entries{};
+  /// The distinct glyph images. The font generator emits a single array for identical glyphs: they share an image.
+  std::array<image, GlyphCount> images{};
+  std::size_t image_count = 0U;
+  /// The total number of bytes of row-major pixel data.
+  std::size_t store_size = 0U;
+  /// The image used for code points that are not present in the font.
+  std::uint16_t fallback = 0U;
+};
+
+template <font const& Font> consteval auto make_atlas_layout() {
+  atlas_layout<Font.glyphs.size()> layout;
+  auto const height = static_cast<std::uint16_t>(Font.height * 8U);
+  auto const find_image = [&layout](std::byte const* const source) {
+    auto const first = layout.images.begin();
+    auto const last = first + static_cast<std::ptrdiff_t>(layout.image_count);
+    return static_cast<std::uint16_t>(std::ranges::find(first, last, source, [](auto const& img) {
+                                        return img.source.data();
+                                      }) -
+                                      first);
+  };
+
+  auto entry = layout.entries.begin();
+  for (auto const& [code_point, g] : Font.glyphs) {
+    auto const index = find_image(g.bm.data());
+    if (index == layout.image_count) {
+      auto const width = Font.width(g);
+      layout.images[index] = {.source = g.bm, .width = width, .offset = layout.store_size};
+      layout.store_size += bitmap::required_store_size(width, height);
+      ++layout.image_count;
+    }
+    *(entry++) = atlas_entry{.code_point = static_cast<char32_t>(code_point), .image = index};
+  }
+  std::ranges::sort(layout.entries, std::ranges::less{}, &atlas_entry::code_point);
+  layout.fallback = find_image(Font.find_glyph(white_square)->bm.data());
+  return layout;
+}
+template <font const& Font> inline constexpr auto atlas_layout_v = make_atlas_layout<Font>();
+
+/// Converts each of the font's glyphs to row-major order.
+template <font const& Font> consteval auto make_atlas_store() {
+  constexpr auto const& layout = atlas_layout_v<Font>;
+  std::array<std::byte, layout.store_size> store{};
+  for (auto const& img : std::span{layout.images}.first(layout.image_count)) {
+    if constexpr (Font.layout == glyph_layout::row_major) {
+      std::ranges::copy(img.source, store.begin() + static_cast<std::ptrdiff_t>(img.offset));
+    } else {
+      auto const stride = bitmap::required_stride(img.width);
+      for (auto x = 0U; x < img.width; ++x) {
+        auto const mask = std::byte{0x80} >> (x % 8U);
+        for (auto row = 0U; row < Font.height; ++row) {
+          // Visit only the ink pixels of this 8 pixel tall segment of the column.
+          for (auto bits = std::to_integer<unsigned>(img.source[x * Font.height + row]); bits != 0U;
+               bits &= bits - 1U) {
+            auto const y = row * 8U + static_cast<unsigned>(std::countr_zero(bits));
+            store[img.offset + y * stride + x / 8U] |= mask;
+          }
+        }
+      }
+    }
+  }
+  return store;
+}
+template <font const& Font> inline constexpr auto atlas_store_v = make_atlas_store<Font>();
+
+template <font const& Font> consteval auto make_atlas_bitmaps() {
+  constexpr auto const& layout = atlas_layout_v<Font>;
+  auto const height = static_cast<std::uint16_t>(Font.height * 8U);
+  // The bitmaps are only ever exposed as 'bitmap const' so the pixel data is never modified.
+  auto* const store = const_cast<std::byte*>(atlas_store_v<Font>.data());
+  std::array<bitmap, layout.image_count> result{};
+  for (auto index = std::size_t{0}; index < layout.image_count; ++index) {
+    auto const& img = layout.images[index];
+    result[index] = bitmap{std::span{store + img.offset, bitmap::required_store_size(img.width, height)}, img.width,
+                           height};
+  }
+  return result;
+}
+template <font const& Font> inline constexpr auto atlas_bitmaps_v = make_atlas_bitmaps<Font>();
+template <font const& Font> inline constexpr auto atlas_entries_v = atlas_layout_v<Font>.entries;
+
+}  // end namespace details
+
+/// A glyph source which holds every glyph of a single font pre-rendered at compile time. The glyphs are stored in
+/// read-only memory so, unlike glyph_cache, no RAM is needed for the glyph images and glyphs are never rendered at run
+/// time.
+///
+/// \tparam Font  The font whose glyphs are held by the atlas.
+template <font const& Font> class glyph_atlas final : public glyph_source {
+public:
+  constexpr glyph_atlas() noexcept = default;
+
+  /// Returns a bitmap containing the rendered glyph from the supplied font. \p f must be the atlas' font.
+  [[nodiscard]] bitmap const& get([[maybe_unused]] font const& f, char32_t const code_point) override {
+    assert(f.id == Font.id && "The font is not held by this glyph atlas");
+    return glyph_atlas::find(code_point);
+  }
+  /// Returns a bitmap containing the rendered glyph for \p code_point. If the font does not contain \p code_point
+  /// the result is the same glyph as is chosen by font::find_glyph().
+  [[nodiscard]] static constexpr bitmap const& find(char32_t const code_point) noexcept {
+    auto const& entries = details::atlas_entries_v<Font>;
+    auto const pos = std::ranges::lower_bound(entries, code_point, std::ranges::less{},
+                                              &details::atlas_entry::code_point);
+    auto const found = pos != std::end(entries) && pos->code_point == code_point;
+    return details::atlas_bitmaps_v<Font>[found ? pos->image : details::atlas_layout_v<Font>.fallback];
+  }
+
+  /// The number of bytes of pixel data held by the atlas.
+  static constexpr std::size_t store_size = details::atlas_layout_v<Font>.store_size;
+};
+
+}  // end namespace draw
+
+#endif  // DRAW_GLYPH_ATLAS_HPP
@@ -32,67 +32,378 @@
 #define DRAW_GLYPH_CACHE_HPP
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ranges>
 #include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include "bitmap.hpp"
 #include "font.hpp"
 #include "plru_cache.hpp"
+#include "text.hpp"
+
+#ifndef DRAW_HOSTED
+#define DRAW_HOSTED (0)
+#endif
+
+#if DRAW_HOSTED
+#include <chrono>
+#endif
 
 namespace draw {
 
-class glyph_cache {
+/// A snapshot of the activity of a glyph cache whose statistics are enabled (see basic_glyph_cache).
+struct glyph_cache_stats {
+  std::uint32_t hits = 0U;       ///< Requests satisfied without rendering a glyph.
+  std::uint32_t misses = 0U;     ///< Requests for which a glyph had to be rendered.
+  std::uint32_t evictions = 0U;  ///< Misses which displaced a previously cached glyph.
+  /// The number of misses for each font, indexed by font id.
+  std::array<std::uint32_t, 256> font_misses{};
+  /// The total time spent rendering glyphs in nanoseconds. This is measured only in hosted environments.
+  std::uint64_t render_ns = 0U;
+};
+
+namespace details {
+
+/// Records the activity of a glyph cache.
+class glyph_cache_counters {
+public:
+  constexpr void lookup() noexcept { ++lookups_; }
+  /// Records a miss for a glyph from font \p font_id.
+  constexpr void miss(std::uint8_t const font_id) noexcept {
+    ++stats_.misses;
+    ++stats_.font_misses[font_id];
+  }
+  /// Records that \p count glyphs were evicted to make room for another.
+  constexpr void evict(unsigned const count) noexcept { stats_.evictions += count; }
+  /// Calls \p fn and adds the time that it takes to the total render time.
+  template <typename RenderFn> auto render(RenderFn const& fn) {
+#if DRAW_HOSTED
+    using clock = std::chrono::steady_clock;
+    auto const start = clock::now();
+    auto result = fn();
+    stats_.render_ns += static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count());
+    return result;
+#else
+    return fn();
+#endif  // DRAW_HOSTED
+  }
+
+  [[nodiscard]] constexpr glyph_cache_stats snapshot() const noexcept {
+    auto result = stats_;
+    result.hits = lookups_ - stats_.misses;
+    return result;
+  }
+  /// Zeroes the counters.
+  constexpr void reset() noexcept {
+    lookups_ = 0U;
+    stats_ = glyph_cache_stats{};
+  }
+
+private:
+  std::uint32_t lookups_ = 0U;
+  glyph_cache_stats stats_{};
+};
+
+/// A glyph held by a glyph cache.
+struct cached_glyph {
+  bitmap bm;
+  /// False if the glyph's storage was reclaimed to make room for another glyph. It will be rendered again when next
+  /// requested.
+  bool live = false;
+};
+
+/// The storage allocated to a glyph cache entry.
+struct glyph_slot {
+  cached_glyph* glyph = nullptr;  ///< The cache entry or nullptr if the entry has never been used.
+  std::uint32_t offset = 0U;      ///< The position of the glyph's pixels relative to the start of its set's storage.
+  std::uint32_t size = 0U;        ///< The number of bytes occupied by the glyph's pixels.
+};
+
+/// Manages the storage for the pixels of a glyph cache's glyphs. Each cache set owns an equal share of the store in
+/// which its glyphs are packed together in the order in which they were rendered, so each glyph occupies only as many
+/// bytes as it needs. When a glyph is evicted the glyphs that follow it are moved down to close the gap. If a new
+/// glyph does not fit in the space left, further glyphs of the same set are dropped until it does.
+class glyph_slab {
+public:
+  struct allocation {
+    std::span<std::byte> store;  ///< The storage for the new glyph.
+    unsigned evicted = 0U;       ///< The number of glyphs that were evicted to make room for it.
+  };
+
+  constexpr glyph_slab(std::span<std::byte> const& store, std::span<glyph_slot> const& slots,
+                       std::size_t const ways) noexcept
+      : store_{store}, slots_{slots}, ways_{ways}, set_size_{store.size() / (slots.size() / ways)} {}
+
+  /// \returns The number of bytes available to each cache set.
+  [[nodiscard]] constexpr std::size_t set_size() const noexcept { return set_size_; }
+
+  /// Allocates \p size bytes for the glyph to be held by cache entry \p index. The glyph previously held by the entry
+  /// is evicted.
+  [[nodiscard]] allocation allocate(std::size_t index, std::size_t size);
+  /// Records the cache entry that holds the glyph at \p index.
+  constexpr void bind(std::size_t const index, cached_glyph* const DRAW_NONNULL glyph) noexcept {
+    slots_[index].glyph = glyph;
+  }
+
 private:
+  [[nodiscard]] constexpr bool live(std::size_t const index) const noexcept {
+    auto const* const glyph = slots_[index].glyph;
+    return glyph != nullptr && glyph->live;
+  }
+  /// \returns The number of bytes in use by the set whose first cache entry is \p first.
+  [[nodiscard]] std::size_t used(std::size_t first) const noexcept;
+  /// Releases the storage of the glyph at \p index and marks it as no longer live.
+  void release(std::size_t index);
+
+  std::span<std::byte> store_;
+  std::span<glyph_slot> slots_;
+  std::size_t ways_;
+  std::size_t set_size_;
+};
+
+/// The counters used by a glyph cache whose statistics are disabled. Every member does nothing.
+class no_glyph_cache_counters {
+public:
+  constexpr void lookup() const noexcept {}
+  constexpr void miss(std::uint8_t /*font_id*/) const noexcept {}
+  constexpr void evict(unsigned /*count*/) const noexcept {}
+  template <typename RenderFn> auto render(RenderFn const& fn) const { return fn(); }
+};
+
+}  // end namespace details
+
+/// The interface through which bitmaps obtain the rendered glyphs that they draw.
+class glyph_source {
+public:
+  /// Returns a bitmap containing the rendered glyph from the supplied font.
+  [[nodiscard]] virtual bitmap const& get(font const& f, char32_t code_point) = 0;
+
+protected:
+  constexpr glyph_source() noexcept = default;
+  constexpr glyph_source(glyph_source const&) noexcept = default;
+  constexpr glyph_source(glyph_source&&) noexcept = default;
+  constexpr ~glyph_source() noexcept = default;
+  constexpr glyph_source& operator=(glyph_source const&) noexcept = default;
+  constexpr glyph_source& operator=(glyph_source&&) noexcept = default;
+
+  /// The number of bits used to represent a code point.
+  static constexpr auto code_point_bits = 21U;
+
+  /// Renders an individual glyph into the supplied bitmap.
+  [[nodiscard]] static bitmap render(font const& f, char32_t code_point, std::span<std::byte> bitmap_store);
+
+  /// Returns the number of bytes required to render the glyph for \p code_point from font \p f.
+  [[nodiscard]] static constexpr std::size_t get_glyph_store_size(font const& f, char32_t const code_point) {
+    if (f.layout == glyph_layout::row_major) {
+      return 0U;  // Row-major glyphs are drawn directly from the font data.
+    }
+    return bitmap::required_store_size(f.width(*f.find_glyph(code_point)), static_cast<std::uint16_t>(f.height * 8U));
+  }
+  /// Returns the number of bytes required for the largest glyph in the supplied font.
+  [[nodiscard]] static constexpr std::size_t get_font_store_size(font const& f) noexcept {
+    std::size_t const stride = (f.widest + 7U) / 8U;
+    auto const pixel_height = f.height * 8U;
+    return stride * pixel_height;
+  }
   template <std::ranges::input_range FontsRange>
   [[nodiscard]] static constexpr std::size_t get_store_size(FontsRange&& fonts) noexcept {
-    return std::ranges::max(std::forward<FontsRange>(fonts) | std::views::transform(glyph_cache::get_font_store_size));
+    return std::ranges::max(std::forward<FontsRange>(fonts) |
+                            std::views::transform(glyph_source::get_font_store_size));
   }
+};
+
+/// A cache of rendered glyphs. Glyphs are held in a "Tree-PLRU" cache (see plru_cache<>) of Sets * Ways entries.
+///
+/// The store is shared equally between the cache sets and each glyph uses only the bytes that it needs within its
+/// set's share (see details::glyph_slab). get_size() returns the store size at which every entry can hold the largest
+/// glyph of the cache's fonts. A smaller store, which must be able to hold at least one of the largest glyphs per set,
+/// may be used with a larger number of ways: a set then holds as many glyphs as fit, so fonts with many small glyphs
+/// make better use of the memory.
+///
+/// \tparam Sets  The number of cache sets. Glyphs are assigned to a set by the low bits of their code point. Must be
+///   a power of 2.
+/// \tparam Ways  The number of glyphs that can be held by each set. Must be a power of 2.
+/// \tparam Partitions  The number of groups into which the sets are divided by font id. Glyphs of fonts in
+///   different partitions never compete for a slot, so heavy use of one font cannot evict every glyph of another.
+///   Must be a power of 2 no greater than \p Sets.
+/// \tparam Stats  If true, the cache counts its hits, misses, and evictions along with the time spent rendering
+///   glyphs. These are available from stats(). If false, no time or memory is spent on these counters.
+template <std::size_t Sets, std::size_t Ways, std::size_t Partitions = 1U, bool Stats = false>
+  requires(std::has_single_bit(Partitions) && Partitions <= Sets)
+class basic_glyph_cache final : public glyph_source {
+  static constexpr unsigned set_bits = std::bit_width(Sets - 1U);
+  static constexpr unsigned partition_bits = std::bit_width(Partitions - 1U);
+  /// The number of bits used to select a set within a partition.
+  static constexpr unsigned local_set_bits = set_bits - partition_bits;
 
 public:
+  static constexpr std::size_t sets = Sets;
+  static constexpr std::size_t ways = Ways;
+  static constexpr std::size_t partitions = Partitions;
+  /// Keys are formed from a font id and code point along with a copy of the partition number.
+  using key_type = std::conditional_t<(sizeof(font::id) * 8U + code_point_bits + partition_bits <= 32U),
+                                      std::uint32_t, std::uint64_t>;
+
   template <std::ranges::input_range Range>
     requires std::is_same_v<
                  std::remove_cvref_t<std::unwrap_reference_t<std::ranges::range_value_t<std::remove_cvref_t<Range>>>>,
                  font>
-  constexpr glyph_cache(Range&& fonts, std::span<std::byte> const& store) noexcept
-      : store_size_{get_store_size(std::forward<Range>(fonts))}, store_{store} {
-    assert(store_.size_bytes() >= store_size_);
+  constexpr basic_glyph_cache(Range&& fonts, std::span<std::byte> const& store) noexcept
+      : slab_{store, slots_, Ways} {
+    assert(slab_.set_size() >= get_store_size(std::forward<Range>(fonts)) &&
+           "Each cache set must be able to hold the largest glyph");
   }
 
-  constexpr glyph_cache(font const& f, std::span<std::byte> const& store) noexcept
-      : glyph_cache(std::ranges::views::single(std::cref(f)), store) {}
+  constexpr basic_glyph_cache(font const& f, std::span<std::byte> const& store) noexcept
+      : basic_glyph_cache(std::ranges::views::single(std::cref(f)), store) {}
+  // The slot table refers to the cache's own entries so a cache cannot be copied or moved.
+  basic_glyph_cache(basic_glyph_cache const&) = delete;
+  basic_glyph_cache(basic_glyph_cache&&) = delete;
+  ~basic_glyph_cache() noexcept = default;
+
+  basic_glyph_cache& operator=(basic_glyph_cache const&) = delete;
+  basic_glyph_cache& operator=(basic_glyph_cache&&) = delete;
 
   /// Returns a bitmap containing the rendered glyph from the supplied font.
-  [[nodiscard]] bitmap const& get(font const& f, char32_t code_point);
+  [[nodiscard]] bitmap const& get(font const& f, char32_t code_point) override;
+  /// \returns True if the glyph for \p code_point from font \p f is present in the cache.
+  [[nodiscard]] bool contains(font const& f, char32_t const code_point) const noexcept {
+    auto const* const glyph = cache_.find(key(f.id, code_point));
+    return glyph != nullptr && glyph->live;
+  }
+
+  /// Renders the glyphs needed to draw \p s in font \p f ahead of time so that drawing the string does not wait for
+  /// glyphs to be rendered.
+  ///
+  /// \returns True if every glyph of the string is held by the cache once it has been warmed. False if the string's
+  ///   glyphs do not fit the cache's geometry: some of them evicted others.
+  bool warm(font const& f, std::u8string_view const s) {
+    std::ignore = scan_string(f, s, [this, &f](char32_t const code_point, coordinate) {
+      std::ignore = this->get(f, code_point);
+    });
+    auto fits = true;
+    std::ignore = scan_string(f, s, [this, &f, &fits](char32_t const code_point, coordinate) {
+      fits = fits && this->contains(f, code_point);
+    });
+    return fits;
+  }
+  /// Renders the glyphs for each of the code points in the closed range [\p first, \p last] from font \p f ahead of
+  /// time.
+  ///
+  /// \returns True if every glyph of the range is held by the cache once it has been warmed. False if the glyphs do not
+  ///   fit the cache's geometry.
+  bool warm(font const& f, char32_t const first, char32_t const last) {
+    assert(first <= last && last <= char32_t{0x10FFFF} && "The code point range is not valid");
+    for (auto code_point = first; code_point <= last; ++code_point) {
+      std::ignore = this->get(f, code_point);
+    }
+    for (auto code_point = first; code_point <= last; ++code_point) {
+      if (!this->contains(f, code_point)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \returns A snapshot of the cache's activity since it was created or since the last call to reset_stats().
+  [[nodiscard]] constexpr glyph_cache_stats stats() const noexcept
+    requires(Stats)
+  {
+    return counters_.snapshot();
+  }
+  /// Zeroes the cache's statistics.
+  constexpr void reset_stats() noexcept
+    requires(Stats)
+  {
+    counters_.reset();
+  }
 
   template <std::ranges::input_range FontsRange>
     requires std::is_same_v<
         std::remove_cvref_t<std::unwrap_reference_t<std::ranges::range_value_t<std::remove_cvref_t<FontsRange>>>>, font>
   [[nodiscard]] static constexpr std::size_t get_size(FontsRange&& fonts) noexcept {
-    return decltype(cache_)::max_size() * glyph_cache::get_store_size(std::forward<FontsRange>(fonts));
+    return cache_type::max_size() * get_store_size(std::forward<FontsRange>(fonts));
   }
   [[nodiscard]] static constexpr std::size_t get_size(font const& f) noexcept {
     auto const fonts = std::ranges::views::single(std::cref(f));
     return get_size(fonts);
   }
 
+  /// \returns The cache key for a glyph. The least significant bits, which select the cache set, are the partition
+  ///   number followed by the low bits of the code point.
+  [[nodiscard]] static constexpr key_type key(std::uint8_t const font_id, char32_t const code_point) noexcept {
+    auto const k = (key_type{font_id} << code_point_bits) | static_cast<key_type>(code_point);
+    if constexpr (Partitions == 1U) {
+      return k;
+    } else {
+      auto const local_set = k & ((key_type{1} << local_set_bits) - 1U);
+      auto const partition = key_type{font_id} & (Partitions - 1U);
+      return ((k >> local_set_bits) << set_bits) | (partition << local_set_bits) | local_set;
+    }
+  }
+
 private:
-  /// Renders an individual glyph into the supplied bitmap.
-  [[nodiscard]] static bitmap render(font const& f, char32_t code_point, std::span<std::byte> bitmap_store);
+  using cache_type = plru_cache<key_type, details::cached_glyph, Sets, Ways>;
 
-  /// Returns the number of bytes required for the largest glyph in the supplied font.
-  [[nodiscard]] static constexpr std::size_t get_font_store_size(font const& f) noexcept {
-    std::size_t const stride = (f.widest + 7U) / 8U;
-    auto const pixel_height = f.height * 8U;
-    return stride * pixel_height;
+  /// The storage assigned to each cache entry.
+  std::array<details::glyph_slot, Sets * Ways> slots_{};
+  /// Allocates the storage for the glyph pixels from the store.
+  details::glyph_slab slab_;
+  cache_type cache_;
+  [[no_unique_address]] std::conditional_t<Stats, details::glyph_cache_counters, details::no_glyph_cache_counters>
+      counters_;
+};
+
+template <std::size_t Sets, std::size_t Ways, std::size_t Partitions, bool Stats>
+  requires(std::has_single_bit(Partitions) && Partitions <= Sets)
+bitmap const& basic_glyph_cache<Sets, Ways, Partitions, Stats>::get(font const& f, char32_t const code_point) {
+  counters_.lookup();
+  constexpr auto no_entry = std::numeric_limits<std::size_t>::max();
+  auto rendered = no_entry;
+  auto& result = cache_.access(
+      key(f.id, code_point),
+      [this, &f, code_point, &rendered](key_type const /*key*/, std::size_t const index) {
+        // Called when a glyph was not found in the cache or its storage has been reclaimed.
+        counters_.miss(f.id);
+        auto const allocation = slab_.allocate(index, get_glyph_store_size(f, code_point));
+        counters_.evict(allocation.evicted);
+        rendered = index;
+        return details::cached_glyph{
+            .bm = counters_.render([&f, code_point, &allocation] {
+              return glyph_source::render(f, code_point, allocation.store);
+            }),
+            .live = true};
+      },
+      [](details::cached_glyph const& g) { return g.live; });
+  if (rendered != no_entry) {
+    slab_.bind(rendered, &result);
   }
+  return result.bm;
+}
 
-  /// The size of the largest glyph that can be held by the cache.
-  std::size_t store_size_;
-  /// A block of memory that is large enough to contain a full cache of the largest glyph in the font.
-  std::span<std::byte> store_;
-  plru_cache<std::uint32_t, bitmap, 8U, 2U> cache_;
+/// The default glyph cache geometry: 8 sets of 2 ways.
+using glyph_cache = basic_glyph_cache<8U, 2U>;
+
+/// A glyph source for fonts whose glyphs are stored in row-major order (see glyph_layout). The bitmaps that it returns
+/// refer directly to the font data so, unlike glyph_cache, it needs no memory for rendered glyphs.
+class glyph_view final : public glyph_source {
+public:
+  /// Returns a bitmap referring to the glyph from the supplied font. The result remains valid until the next call.
+  [[nodiscard]] bitmap const& get(font const& f, char32_t code_point) override;
+
+private:
+  bitmap bm_;
 };
 
 }  // end namespace draw
@@ -0,0 +1,98 @@
+//===- include/draw/gray_bitmap.hpp -----------------------*- mode: C++ -*-===//
+//*                          _     _ _                          *
+//*   __ _ _ __ __ _ _   _  | |__ (_) |_ _ __ ___   __ _ _ __   *
+//*  / _` | '__/ _` | | | | | '_ \| | __| '_ ` _ \ / _` | '_ \  *
+//* | (_| | | | (_| | |_| | | |_) | | |_| | | | | | (_| | |_) | *
+//*  \__, |_|  \__,_|\__, | |_.__/|_|\__|_| |_| |_|\__,_| .__/  *
+//*  |___/           |___/                              |_|     *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+#ifndef DRAW_GRAY_BITMAP_HPP
+#define DRAW_GRAY_BITMAP_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "draw/basic_bitmap.hpp"
+#include "draw/types.hpp"
+
+namespace draw {
+
+class bitmap;
+struct font;
+class glyph_source;
+
+/// A greyscale bitmap with 2 (4 levels) or 4 (16 levels) bits per pixel, suitable for multi-level e-paper panels.
+/// A pixel value of 0 is paper (white) and packed_format<Bits>::max_value is full ink (black).
+template <unsigned Bits>
+  requires(Bits == 2U || Bits == 4U)
+class gray_bitmap : public basic_bitmap<packed_format<Bits>> {
+  using base = basic_bitmap<packed_format<Bits>>;
+
+public:
+  using typename base::value_type;
+  using base::base;
+
+  /// Copies the whole of \p source to this bitmap, replacing the pixels that it covers.
+  ///
+  /// \param source  The bitmap to be copied
+  /// \param dest_pos  The position in this bitmap of the top-left corner of \p source
+  void copy(gray_bitmap const& source, point dest_pos);
+  /// Paints the pixels of this bitmap that correspond to set pixels of a 1bpp bitmap with the \p fg level.
+  ///
+  /// \param source  The 1bpp bitmap to be expanded
+  /// \param src_rect  The (inclusive) area of \p source to be expanded
+  /// \param dest_pos  The position in this bitmap of the top-left corner of \p src_rect
+  /// \param fg  The level of pixels corresponding to set source pixels
+  /// \param bg  The level of pixels corresponding to clear source pixels. If omitted, those pixels are left unchanged.
+  void expand(bitmap const& source, rect const& src_rect, point dest_pos, value_type fg,
+              std::optional<value_type> bg = std::nullopt);
+
+  /// Renders an individual glyph with the given ink level.
+  ///
+  /// \param gc  The glyph cache
+  /// \param f  The font in which the character will be rendered
+  /// \param code_point  The code point specifying the glyph to be drawn
+  /// \param pos The position at which the glyph should be drawn
+  /// \param ink  The level with which the glyph's pixels are painted
+  void draw_char(glyph_source& gc, font const& f, char32_t code_point, point pos, value_type ink);
+  /// \param gc  The glyph cache
+  /// \param f  The font in which the character will be rendered
+  /// \param s  The UTF-8 encoded string to be drawn
+  /// \param pos  The position for the first of the run of glyphs
+  /// \param ink  The level with which the glyphs' pixels are painted
+  /// \returns  The origin position \p pos with the x coordinate increased by the width of all the rendered glyphs.
+  point draw_string(glyph_source& gc, font const& f, std::u8string_view s, point pos, value_type ink);
+};
+
+extern template class gray_bitmap<2>;
+extern template class gray_bitmap<4>;
+
+using gray2_bitmap = gray_bitmap<2>;
+using gray4_bitmap = gray_bitmap<4>;
+
+}  // end namespace draw
+
+#endif  // DRAW_GRAY_BITMAP_HPP
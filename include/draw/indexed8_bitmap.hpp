@@ -0,0 +1,88 @@
+//===- include/draw/indexed8_bitmap.hpp -------------------*- mode: C++ -*-===//
+//*  _           _                   _  ___    _     _ _                          *
+//* (_)_ __   __| | _____  _____  __| |( _ )  | |__ (_) |_ _ __ ___   __ _ _ __   *
+//* | | '_ \ / _` |/ _ \ \/ / _ \/ _` |/ _ \  | '_ \| | __| '_ ` _ \ / _` | '_ \  *
+//* | | | | | (_| |  __/>  <  __/ (_| | (_) | | |_) | | |_| | | | | | (_| | |_) | *
+//* |_|_| |_|\__,_|\___/_/\_\___|\__,_|\___/  |_.__/|_|\__|_| |_| |_|\__,_| .__/  *
+//*                                                                       |_|     *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+#ifndef DRAW_INDEXED8_BITMAP_HPP
+#define DRAW_INDEXED8_BITMAP_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "draw/basic_bitmap.hpp"
+#include "draw/types.hpp"
+
+namespace draw {
+
+class bitmap;
+struct font;
+class glyph_source;
+
+/// A bitmap of 8-bit palette indices. Each pixel occupies a byte so drawing never needs to mask or shift: fills are
+/// memsets and glyphs are expanded to an index a byte at a time. The palette is applied only when the bitmap is
+/// flushed to a panel (see convert() in convert.hpp) which needs a quarter of the memory of a bitmap32.
+class indexed8_bitmap : public basic_bitmap<indexed8_format> {
+public:
+  using basic_bitmap::basic_bitmap;
+
+  /// Copies the whole of \p source to this bitmap, replacing the pixels that it covers.
+  ///
+  /// \param source  The bitmap to be copied
+  /// \param dest_pos  The position in this bitmap of the top-left corner of \p source
+  void copy(indexed8_bitmap const& source, point dest_pos);
+  /// Paints the pixels of this bitmap that correspond to set pixels of a 1bpp bitmap with the index \p fg.
+  ///
+  /// \param source  The 1bpp bitmap to be expanded
+  /// \param src_rect  The (inclusive) area of \p source to be expanded
+  /// \param dest_pos  The position in this bitmap of the top-left corner of \p src_rect
+  /// \param fg  The index of pixels corresponding to set source pixels
+  /// \param bg  The index of pixels corresponding to clear source pixels. If omitted, those pixels are left unchanged.
+  void expand(bitmap const& source, rect const& src_rect, point dest_pos, value_type fg,
+              std::optional<value_type> bg = std::nullopt);
+
+  /// Renders an individual glyph with the given palette index.
+  ///
+  /// \param gc  The glyph cache
+  /// \param f  The font in which the character will be rendered
+  /// \param code_point  The code point specifying the glyph to be drawn
+  /// \param pos The position at which the glyph should be drawn
+  /// \param index  The palette index with which the glyph's pixels are painted
+  void draw_char(glyph_source& gc, font const& f, char32_t code_point, point pos, value_type index);
+  /// \param gc  The glyph cache
+  /// \param f  The font in which the character will be rendered
+  /// \param s  The UTF-8 encoded string to be drawn
+  /// \param pos  The position for the first of the run of glyphs
+  /// \param index  The palette index with which the glyphs' pixels are painted
+  /// \returns  The origin position \p pos with the x coordinate increased by the width of all the rendered glyphs.
+  point draw_string(glyph_source& gc, font const& f, std::u8string_view s, point pos, value_type index);
+};
+
+}  // end namespace draw
+
+#endif  // DRAW_INDEXED8_BITMAP_HPP
@@ -0,0 +1,198 @@
+//===- include/draw/label_cache.hpp -----------------------*- mode: C++ -*-===//
+//*  _       _          _                  _           *
+//* | | __ _| |__   ___| |   ___ __ _  ___| |__   ___  *
+//* | |/ _` | '_ \ / _ \ |  / __/ _` |/ __| '_ \ / _ \ *
+//* | | (_| | |_) |  __/ | | (_| (_| | (__| | | |  __/ *
+//* |_|\__,_|_.__/ \___|_|  \___\__,_|\___|_| |_|\___| *
+//*                                                    *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+#ifndef DRAW_LABEL_CACHE_HPP
+#define DRAW_LABEL_CACHE_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string_view>
+
+#include "bitmap.hpp"
+#include "bitmap32.hpp"
+#include "font.hpp"
+#include "glyph_cache.hpp"
+#include "plru_cache.hpp"
+
+namespace draw {
+
+namespace details {
+
+/// \returns The width in pixels of the label \p s when drawn in font \p f.
+[[nodiscard]] std::uint16_t label_width(font const& f, std::u8string_view s);
+/// Draws the label \p s into a bitmap of \p width pixels built over \p store using glyphs obtained from \p gc.
+[[nodiscard]] bitmap render_label(glyph_source& gc, font const& f, std::u8string_view s, std::uint16_t width,
+                                  std::span<std::byte> store);
+
+}  // end namespace details
+
+/// A cache of rendered text labels. Static labels that are drawn on every frame are laid out and rendered once into
+/// a single 1bpp bitmap so that subsequent draws cost one copy rather than a transcode, kerning search, and copy per
+/// glyph. Labels are held in a "Tree-PLRU" cache (see plru_cache<>) of Sets * Ways entries which is independent of
+/// the glyph cache used to render them.
+///
+/// Labels are identified by their font and a 56-bit hash of their text; the text itself is not retained. As for
+/// basic_glyph_cache, the store is shared equally between the cache sets and each label occupies only the bytes that
+/// it needs (see details::glyph_slab). A label that is too large for a set is drawn glyph by glyph instead.
+///
+/// \tparam Sets  The number of cache sets. Labels are assigned to a set by the low bits of their hash. Must be a
+///   power of 2.
+/// \tparam Ways  The number of labels that can be held by each set. Must be a power of 2.
+template <std::size_t Sets, std::size_t Ways> class basic_label_cache {
+public:
+  static constexpr std::size_t sets = Sets;
+  static constexpr std::size_t ways = Ways;
+  using key_type = std::uint64_t;
+
+  /// \param gc  The glyph source from which labels are rendered.
+  /// \param store  The memory in which rendered labels are held.
+  constexpr basic_label_cache(glyph_source& gc, std::span<std::byte> const& store) noexcept
+      : gc_{gc}, slab_{store, slots_, Ways} {}
+  // The slot table refers to the cache's own entries so a cache cannot be copied or moved.
+  basic_label_cache(basic_label_cache const&) = delete;
+  basic_label_cache(basic_label_cache&&) = delete;
+  ~basic_label_cache() noexcept = default;
+
+  basic_label_cache& operator=(basic_label_cache const&) = delete;
+  basic_label_cache& operator=(basic_label_cache&&) = delete;
+
+  /// \returns The store size needed for every cache entry to hold a label of up to \p width pixels in font \p f.
+  [[nodiscard]] static constexpr std::size_t get_size(font const& f, std::uint16_t const width) noexcept {
+    return cache_type::max_size() * bitmap::required_store_size(width, static_cast<std::uint16_t>(f.height * 8U));
+  }
+
+  /// \returns The rendered label for string \p s in font \p f or nullptr if the label is too large to be cached.
+  [[nodiscard]] bitmap const* get(font const& f, std::u8string_view s);
+  /// \returns True if the label for string \p s in font \p f is present in the cache.
+  [[nodiscard]] bool contains(font const& f, std::u8string_view const s) const noexcept {
+    auto const* const label = cache_.find(key(f.id, s));
+    return label != nullptr && label->live;
+  }
+
+  /// Draws the label \p s in font \p f into a 1bpp bitmap.
+  ///
+  /// \param dest  The bitmap into which the label is drawn
+  /// \param f  The font in which the label will be rendered
+  /// \param s  The UTF-8 encoded label to be drawn
+  /// \param pos  The position of the top-left corner of the label
+  /// \returns  The origin position \p pos with the x coordinate increased by the width of the label.
+  point draw(bitmap& dest, font const& f, std::u8string_view const s, point const pos) {
+    auto const* const label = this->get(f, s);
+    if (label == nullptr) {
+      return dest.draw_string(gc_, f, s, pos);
+    }
+    if (label->width() > 0U) {
+      dest.copy(*label, pos, bitmap::transfer_mode::mode_or);
+    }
+    return {.x = static_cast<coordinate>(pos.x + label->width()), .y = pos.y};
+  }
+  /// Draws the label \p s in font \p f and the color \p color into a 32bpp bitmap.
+  ///
+  /// \param dest  The bitmap into which the label is drawn
+  /// \param f  The font in which the label will be rendered
+  /// \param s  The UTF-8 encoded label to be drawn
+  /// \param pos  The position of the top-left corner of the label
+  /// \param color  The color in which the label will be drawn
+  /// \returns  The origin position \p pos with the x coordinate increased by the width of the label.
+  point draw(bitmap32& dest, font const& f, std::u8string_view const s, point const pos, rgba const& color) {
+    auto const* const label = this->get(f, s);
+    if (label == nullptr) {
+      return dest.draw_string(gc_, f, s, pos, color);
+    }
+    if (label->width() > 0U) {
+      dest.expand(*label, label->bounds(), pos, color);
+    }
+    return {.x = static_cast<coordinate>(pos.x + label->width()), .y = pos.y};
+  }
+
+  /// \returns The cache key for a label: a 64-bit FNV-1a hash of the string whose top 8 bits are replaced by the
+  ///   font id. The low bits of an FNV-1a hash depend only on the low bits of each byte so the upper half of the hash
+  ///   is folded into the lower to make the bits that select the cache set depend on the whole string.
+  [[nodiscard]] static constexpr key_type key(std::uint8_t const font_id, std::u8string_view const s) noexcept {
+    constexpr auto hash_bits = 56U;
+    auto hash = std::uint64_t{0xCBF29CE484222325};
+    for (auto const cu : s) {
+      hash = (hash ^ static_cast<std::uint8_t>(cu)) * std::uint64_t{0x100000001B3};
+    }
+    hash ^= hash >> 32U;
+    return (key_type{font_id} << hash_bits) | (hash & ((key_type{1} << hash_bits) - 1U));
+  }
+
+private:
+  using cache_type = plru_cache<key_type, details::cached_glyph, Sets, Ways>;
+
+  glyph_source& gc_;
+  /// The storage assigned to each cache entry.
+  std::array<details::glyph_slot, Sets * Ways> slots_{};
+  /// Allocates the storage for the label pixels from the store.
+  details::glyph_slab slab_;
+  cache_type cache_;
+};
+
+template <std::size_t Sets, std::size_t Ways>
+bitmap const* basic_label_cache<Sets, Ways>::get(font const& f, std::u8string_view const s) {
+  auto const k = key(f.id, s);
+  auto width = std::uint16_t{0};
+  auto size = std::size_t{0};
+  if (!this->contains(f, s)) {
+    // Check that the label will fit before anything is evicted to make room for it.
+    width = details::label_width(f, s);
+    size = bitmap::required_store_size(width, static_cast<std::uint16_t>(f.height * 8U));
+    if (size > slab_.set_size()) {
+      return nullptr;
+    }
+  }
+  constexpr auto no_entry = std::numeric_limits<std::size_t>::max();
+  auto rendered = no_entry;
+  auto& result = cache_.access(
+      k,
+      [this, &f, s, width, size, &rendered](key_type const /*key*/, std::size_t const index) {
+        // Called when a label was not found in the cache or its storage has been reclaimed.
+        auto const allocation = slab_.allocate(index, size);
+        rendered = index;
+        return details::cached_glyph{.bm = details::render_label(gc_, f, s, width, allocation.store), .live = true};
+      },
+      [](details::cached_glyph const& g) { return g.live; });
+  if (rendered != no_entry) {
+    slab_.bind(rendered, &result);
+  }
+  return &result.bm;
+}
+
+/// The default label cache geometry: 4 sets of 4 ways.
+using label_cache = basic_label_cache<4U, 4U>;
+
+}  // end namespace draw
+
+#endif  // DRAW_LABEL_CACHE_HPP
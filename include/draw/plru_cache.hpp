@@ -254,6 +254,10 @@ public:
   }
 
   [[nodiscard]] constexpr bool contains(Key key) const noexcept { return find_matching(tagged_key_type{key}) < Ways; }
+  [[nodiscard]] constexpr MappedType const* find(Key key) const noexcept {
+    auto const vi = find_matching(tagged_key_type{key});
+    return vi < Ways ? &values_[vi].reference() : nullptr;
+  }
   constexpr void clear() noexcept {
     for (auto index = std::size_t{0U}; index < Ways; ++index) {
       if (keys_[index].valid()) {
@@ -456,6 +460,15 @@ public:
     return sets_[plru_cache::set(key)].contains(key);
   }
 
+  /// Searches for an element with a key that compares equivalent to \p key. Unlike access(), this does not change
+  /// the recorded order of use.
+  ///
+  /// \return A pointer to the element's value if there is such an element, otherwise nullptr.
+  [[nodiscard]] constexpr mapped_type const* find(key_type key) const noexcept {
+    assert(plru_cache::set(key) < Sets);
+    return sets_[plru_cache::set(key)].find(key);
+  }
+
   /// \brief Clears the contents of the cache.
   constexpr void clear() noexcept {
     for (ways_type& w : sets_) {
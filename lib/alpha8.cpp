@@ -0,0 +1,55 @@
+//===- lib/alpha8.cpp -----------------------------------------------------===//
+//*        _       _            ___   *
+//*   __ _| |_ __ | |__   __ _ ( _ )  *
+//*  / _` | | '_ \| '_ \ / _` |/ _ \  *
+//* | (_| | | |_) | | | | (_| | (_) | *
+//*  \__,_|_| .__/|_| |_|\__,_|\___/  *
+//*         |_|                       *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+#include "draw/alpha8.hpp"
+
+// Standard library
+#include <cassert>
+#include <cstddef>
+
+// Local includes
+#include "box_blur.hpp"
+
+namespace draw {
+
+void alpha8::box_blur(rect const& r, unsigned const radius, unsigned const passes) {
+  assert(radius <= max_blur_radius && "radius is too great");
+  // Clipping the area as a transfer to itself limits it to the bounds of the bitmap.
+  auto const area = this->clip_blit(r, width_, height_, r.top_left());
+  if (!area || radius == 0U || passes == 0U) {
+    return;
+  }
+  details::box_blur<1>(&store_[static_cast<std::size_t>(area->dest_y) * stride_ + area->dest_x], stride_, area->width,
+                       area->height, radius, passes);
+  this->mark_dirty(*area);
+}
+
+}  // end namespace draw
@@ -0,0 +1,132 @@
+//===- lib/bit_transpose.hpp ------------------------------*- mode: C++ -*-===//
+//*  _     _ _     _                                             *
+//* | |__ (_) |_  | |_ _ __ __ _ _ __  ___ _ __   ___  ___  ___  *
+//* | '_ \| | __| | __| '__/ _` | '_ \/ __| '_ \ / _ \/ __|/ _ \ *
+//* | |_) | | |_  | |_| | | (_| | | | \__ \ |_) | (_) \__ \  __/ *
+//* |_.__/|_|\__|  \__|_|  \__,_|_| |_|___/ .__/ \___/|___/\___| *
+//*                                       |_|                    *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+/// \file bit_transpose.hpp
+/// \brief Conversion of column-major glyph data to the row-major layout of a 1 bit-per-pixel bitmap.
+///
+/// A column-major glyph holds 8 vertically adjacent pixels in each byte whereas a bitmap byte holds 8 horizontally
+/// adjacent pixels. Converting a block of 8 columns by 8 rows is therefore the transpose of an 8x8 bit matrix. The
+/// portable version uses the well-known 64-bit "delta swap" sequence; the SSE2 and NEON versions convert 16 columns at
+/// a time.
+
+#ifndef DRAW_BIT_TRANSPOSE_HPP
+#define DRAW_BIT_TRANSPOSE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__ARM_NEON) && __ARM_NEON
+#include <arm_neon.h>
+#define DRAW_BIT_TRANSPOSE_NEON (1)
+#define DRAW_BIT_TRANSPOSE_SSE2 (0)
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DRAW_BIT_TRANSPOSE_NEON (0)
+#define DRAW_BIT_TRANSPOSE_SSE2 (1)
+#else
+#define DRAW_BIT_TRANSPOSE_NEON (0)
+#define DRAW_BIT_TRANSPOSE_SSE2 (0)
+#endif
+
+#include "draw/types.hpp"
+
+namespace draw::details {
+
+/// Transposes a block of 8x8 pixels.
+///
+/// \param columns  Eight columns of pixels. Byte 7 - i (counting from the least significant) holds column i. The
+///   least significant bit of each byte is the top-most pixel.
+/// \returns Eight rows of pixels. Byte y (counting from the least significant) holds row y with the most significant
+///   bit being the left-most pixel.
+[[nodiscard]] constexpr std::uint64_t transpose8(std::uint64_t columns) noexcept {
+  auto t = (columns ^ (columns >> 7U)) & std::uint64_t{0x00AA00AA00AA00AA};
+  columns ^= t ^ (t << 7U);
+  t = (columns ^ (columns >> 14U)) & std::uint64_t{0x0000CCCC0000CCCC};
+  columns ^= t ^ (t << 14U);
+  t = (columns ^ (columns >> 28U)) & std::uint64_t{0x00000000F0F0F0F0};
+  return columns ^ t ^ (t << 28U);
+}
+
+static_assert(transpose8(std::uint64_t{0x01} << 56U) == 0x80U, "column 0, row 0 should be row 0, column 0");
+static_assert(transpose8(std::uint64_t{0x80}) == std::uint64_t{0x01} << 56U, "column 7, row 7 is row 7, column 7");
+static_assert(transpose8(std::uint64_t{0x02}) == std::uint64_t{0x01} << 8U, "column 7, row 1 is row 1, column 7");
+
+#if DRAW_BIT_TRANSPOSE_SSE2 || DRAW_BIT_TRANSPOSE_NEON
+/// The number of columns converted by transpose16().
+constexpr auto transpose16_columns = 16U;
+
+/// Transposes a block of 16 columns by 8 rows.
+///
+/// \param columns  Sixteen columns of pixels with column i in element i. The least significant bit of each byte is
+///   the top-most pixel.
+/// \param rows  Receives eight rows of two bytes each. Row y is written to rows[y * stride] and rows[y * stride + 1].
+/// \param stride  The distance in bytes between consecutive rows.
+inline void transpose16(std::array<std::uint8_t, transpose16_columns> const& columns, std::byte* const DRAW_NONNULL rows,
+                        std::size_t const stride) noexcept {
+#if DRAW_BIT_TRANSPOSE_SSE2
+  // The columns are loaded in reverse so that the movemask result has column 0 in its most significant bit. Doubling
+  // each byte moves the next row into the byte's top bit.
+  auto v = _mm_set_epi8(static_cast<char>(columns[0]), static_cast<char>(columns[1]), static_cast<char>(columns[2]),
+                        static_cast<char>(columns[3]), static_cast<char>(columns[4]), static_cast<char>(columns[5]),
+                        static_cast<char>(columns[6]), static_cast<char>(columns[7]), static_cast<char>(columns[8]),
+                        static_cast<char>(columns[9]), static_cast<char>(columns[10]), static_cast<char>(columns[11]),
+                        static_cast<char>(columns[12]), static_cast<char>(columns[13]), static_cast<char>(columns[14]),
+                        static_cast<char>(columns[15]));
+  for (auto y = std::size_t{8}; y > 0U; --y) {
+    auto const bits = static_cast<unsigned>(_mm_movemask_epi8(v));
+    auto* const row = rows + (y - 1U) * stride;
+    row[0] = static_cast<std::byte>(bits >> 8U);
+    row[1] = static_cast<std::byte>(bits & 0xFFU);
+    v = _mm_add_epi8(v, v);
+  }
+#else
+  // Each lane is reduced to its column's bit within the output byte then the lanes of each half are summed.
+  static constexpr std::array<std::uint8_t, 16> weights{0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+                                                        0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+  uint8x16_t const v = vld1q_u8(columns.data());
+  uint8x16_t const w = vld1q_u8(weights.data());
+  for (auto y = 0U; y < 8U; ++y) {
+    uint8x16_t const m = vandq_u8(vtstq_u8(v, vdupq_n_u8(static_cast<std::uint8_t>(1U << y))), w);
+    uint8x8_t sum = vpadd_u8(vget_low_u8(m), vget_high_u8(m));
+    sum = vpadd_u8(sum, sum);
+    sum = vpadd_u8(sum, sum);
+    auto* const row = rows + y * stride;
+    row[0] = static_cast<std::byte>(vget_lane_u8(sum, 0));
+    row[1] = static_cast<std::byte>(vget_lane_u8(sum, 1));
+  }
+#endif  // DRAW_BIT_TRANSPOSE_SSE2
+}
+#endif  // DRAW_BIT_TRANSPOSE_SSE2 || DRAW_BIT_TRANSPOSE_NEON
+
+}  // end namespace draw::details
+
+#endif  // DRAW_BIT_TRANSPOSE_HPP
@@ -300,176 +300,26 @@ void bitmap::copy(bitmap const& source, point const dest_pos, transfer_mode cons
                     .right = static_cast<coordinate>(dest_x + src_x_end - src_x_init - 1U)});
 }
 
-void bitmap::line_horizontal(unsigned x0, unsigned x1, unsigned const y, std::byte const pattern) {
-  using namespace draw::literals;
-  if (x0 > x1) {
-    std::swap(x0, x1);  // Ensure that we always go from lower to higher addresses.
-  }
-  // A gross clipping check.
-  if (x0 >= width_ || y >= height_) {
-    return;
-  }
-  // Clamp x1 to the bitmap's right edge.
-  x1 = std::min(x1, width_ - 1U);
-  auto it = store_.begin();
-  std::advance(it, (y * stride_) + (x0 / 8U));
-  assert(it < store_.end() && "iterator is not within the bitmap");
-
-  this->mark_dirty({.top = static_cast<coordinate>(y),
-                    .left = static_cast<coordinate>(x0),
-                    .bottom = static_cast<coordinate>(y),
-                    .right = static_cast<coordinate>(x1)});
-
-  // Masks used to set the least- and most-significant bits of a byte for the line's left- and right-most pixels
-  // respectively.
-  auto const mask_low = 0xFF_b >> (x0 % 8U);
-  auto const mask_high = 0xFF_b << (7U - (x1 % 8U));
-
-  auto bytes = (x1 / 8U) - (x0 / 8U);
-  if (bytes == 0U) {
-    // The line lies entirely within a single byte.
-    auto const mask = mask_low & mask_high;
-    *it = (*it & ~mask) | (mask & pattern);
-    return;
-  }
-
-  // First part of the line up until a byte boundary.
-  *it = (*it & ~mask_low) | (mask_low & pattern);
-  ++it;
-  --bytes;
-
-  // Set 8 pixels at a time going from left to right.
-  for (; bytes > 0U; --bytes) {
-    assert(it < store_.end() && "iterator is not within the bitmap");
-    *it = pattern;
-    ++it;
-  }
-  // The final part of the line.
-  assert(it < store_.end() && "iterator is not within the bitmap");
-  *it = (*it & ~mask_high) | (mask_high & pattern);
-}
-
-void bitmap::line_vertical(unsigned const x, unsigned y0, unsigned y1) {
-  using namespace draw::literals;
-  if (x >= width_) {
-    return;
-  }
-  if (y0 > y1) {
-    std::swap(y0, y1);
-  }
-  if (y0 >= height_) {
-    return;
-  }
-  y1 = std::min(y1 + 1U, static_cast<unsigned>(height_));
-  assert(y0 < y1);
-
-  auto index = y0 * stride_ + x / 8U;
-  auto const bits = 0x80_b >> (x % 8U);
-  for (auto y = y0; y < y1; ++y) {
-    assert(index < store_.size() && "index is not within the bitmap");
-    store_[index] |= bits;
-    index += stride_;
-  }
-
-  this->mark_dirty({.top = static_cast<coordinate>(y0),
-                    .left = static_cast<coordinate>(x),
-                    .bottom = static_cast<coordinate>(y1 - 1U),
-                    .right = static_cast<coordinate>(x)});
-}
-
-void bitmap::line(point p0, point p1) {
-  using namespace draw::literals;
-  if (p0.y == p1.y) {
-    if (p0.y >= 0 && p0.y < height_) {
-      this->line_horizontal(static_cast<std::uint16_t>(std::max(p0.x, coordinate{0})),
-                            static_cast<std::uint16_t>(std::max(p1.x, coordinate{0})), static_cast<std::uint16_t>(p0.y),
-                            0xFF_b);
-    }
-    return;
-  }
-  if (p0.x == p1.x) {
-    if (p0.x >= 0 && p0.x < width_) {
-      this->line_vertical(static_cast<unsigned>(p0.x), static_cast<unsigned>(std::max(p0.y, coordinate{0})),
-                          static_cast<unsigned>(std::max(p1.y, coordinate{0})));
-    }
-    return;
-  }
-
-  auto const sx = p0.x < p1.x ? coordinate{1} : coordinate{-1};
-  auto const sy = p0.y < p1.y ? coordinate{1} : coordinate{-1};
-  auto const dx = std::abs(static_cast<int>(p1.x) - static_cast<int>(p0.x));
-  auto const dy = -std::abs(static_cast<int>(p1.y) - static_cast<int>(p0.y));
-  auto err = dx + dy;
-
-  for (;;) {
-    this->set({.x = p0.x, .y = p0.y}, true);
-    auto const e2 = err * 2;
-    if (e2 >= dy) {
-      if (p0.x == p1.x) {
-        break;
-      }
-      err += dy;
-      p0.x += sx;
-    }
-
-    if (e2 <= dx) {
-      if (p0.y == p1.y) {
-        break;
-      }
-      err += dx;
-      p0.y += sy;
-    }
-  }
-}
-
-void bitmap::frame_rect(rect const& r) {
-  if (r.right < r.left || r.bottom < r.top) {
-    return;
-  }
-  // The top and bottom lines
-  this->line({.x = r.left, .y = r.top}, {.x = r.right, .y = r.top});
-  this->line({.x = r.left, .y = r.bottom}, {.x = r.right, .y = r.bottom});
-  // The left and right lines
-  this->line({.x = r.left, .y = r.top}, {.x = r.left, .y = r.bottom});
-  this->line({.x = r.right, .y = r.top}, {.x = r.right, .y = r.bottom});
-}
-
 using namespace draw::literals;
 pattern const black{.data = {0xFF_b, 0xFF_b, 0xFF_b, 0xFF_b, 0xFF_b, 0xFF_b, 0xFF_b, 0xFF_b}};
 pattern const white{.data = {0x00_b, 0x00_b, 0x00_b, 0x00_b, 0x00_b, 0x00_b, 0x00_b, 0x00_b}};
 pattern const gray{.data = {0xAA_b, 0x55_b, 0xAA_b, 0x55_b, 0xAA_b, 0x55_b, 0xAA_b, 0x55_b}};
 pattern const light_gray{.data = {0x88_b, 0x42_b, 0x88_b, 0x42_b, 0x88_b, 0x42_b, 0x88_b, 0x42_b}};
 
-void bitmap::paint_rect(rect const& r, pattern const& pat) {
-  if (r.bottom < r.top || r.right < r.left || r.bottom < 0 || r.right < 0) {
-    return;
-  }
-  if (r.top >= 0 && static_cast<unsigned>(r.top) >= height_) {
-    return;
-  }
-  auto const x0 = static_cast<std::uint16_t>(std::max(r.left, coordinate{0}));
-  auto const x1 = static_cast<std::uint16_t>(std::max(r.right, coordinate{0}));
-  auto const y0 = static_cast<std::uint16_t>(std::max(r.top, coordinate{0}));
-  auto const y1 = std::min(static_cast<std::uint16_t>(r.bottom), static_cast<std::uint16_t>(height_ - 1U));
-  for (auto y = y0; y <= y1; ++y) {
-    this->line_horizontal(x0, x1, y, pat.data[y % 8U]);
-  }
-}
-
 std::uint16_t bitmap::char_width(font const& f, char32_t code_point) {
   glyph const* const g = f.find_glyph(code_point);
   assert(g != nullptr);
   return f.width(*g);
 }
 
-void bitmap::draw_char(glyph_cache& gc, font const& f, char32_t const code_point, point pos) {
+void bitmap::draw_char(glyph_source& gc, font const& f, char32_t const code_point, point pos) {
   if (pos.x > this->width() || pos.y > this->height()) {
     return;
   }
   this->copy(gc.get(f, code_point), pos, transfer_mode::mode_or);
 }
 
-point bitmap::draw_string(glyph_cache& gc, font const& f, std::u8string_view s, point pos) {
+point bitmap::draw_string(glyph_source& gc, font const& f, std::u8string_view s, point pos) {
   coordinate const new_x = scan_string(f, s, [this, &gc, &f, &pos](char32_t code_point, coordinate x) {
     this->draw_char(gc, f, code_point, {.x = static_cast<coordinate>(pos.x + x), .y = pos.y});
   });
@@ -31,109 +31,639 @@
 
 #include "draw/bitmap32.hpp"
 
-namespace draw {
+// Standard library
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+
+// Local includes
+#include "draw/bitmap.hpp"
+#include "draw/font.hpp"
+#include "draw/glyph_cache.hpp"
+#include "draw/text.hpp"
+#include "draw/types.hpp"
+#include "box_blur.hpp"
+#include "span32.hpp"
+
+namespace {
+
+/// Returns the lane mask for a run of pixels starting at x-ordinate \p x0 with the given row of a pattern. The
+/// pattern is rotated so that lane 0 corresponds to \p x0 and the pattern remains aligned with the bitmap's x axis.
+[[nodiscard]] constexpr draw::details::lane_mask8 pattern_mask(std::byte const pattern, unsigned const x0) noexcept {
+  return draw::details::expand_mask(std::rotl(std::to_integer<std::uint8_t>(pattern), static_cast<int>(x0 % 8U)));
+}
+
+using row_kernel = void (*)(draw::rgba_premult* DRAW_NONNULL, draw::rgba_premult const* DRAW_NONNULL,
+                            std::size_t) noexcept;
 
-void bitmap32::line_horizontal(unsigned x0, unsigned x1, unsigned const y, rgba_premult const& color,
-                               std::byte const pattern) {
-  using namespace draw::literals;
-  if (x0 > x1) {
-    std::swap(x0, x1);  // Ensure that we always go from lower to higher addresses.
+/// Returns the row kernel which implements the transfer mode \p mode.
+[[nodiscard]] row_kernel get_row_kernel(draw::bitmap32::transfer_mode const mode) noexcept {
+  using enum draw::bitmap32::transfer_mode;
+  using draw::details::blend_row;
+  switch (mode) {
+  case mode_clear: return &blend_row<mode_clear>;
+  case mode_src: return &blend_row<mode_src>;
+  case mode_src_over: return &blend_row<mode_src_over>;
+  case mode_dst_over: return &blend_row<mode_dst_over>;
+  case mode_src_in: return &blend_row<mode_src_in>;
+  case mode_dst_out: return &blend_row<mode_dst_out>;
+  case mode_xor: return &blend_row<mode_xor>;
+  case mode_multiply: return &blend_row<mode_multiply>;
+  case mode_screen: return &blend_row<mode_screen>;
+  case mode_darken: return &blend_row<mode_darken>;
+  case mode_lighten: return &blend_row<mode_lighten>;
+  case mode_src_over_linear: return &blend_row<mode_src_over_linear>;
+  default: assert(false && "unknown transfer mode"); return &blend_row<mode_src_over>;
   }
-  // A gross clipping check.
-  if (x0 >= width_ || y >= height_) {
-    return;
+}
+
+/// \returns \p c scaled by \p coverage / 255.
+[[nodiscard]] constexpr draw::rgba_premult scale(draw::rgba_premult const& c, unsigned const coverage) noexcept {
+  auto const mul = [coverage](std::uint8_t const v) {
+    auto const x = static_cast<unsigned>(v) * coverage;
+    return static_cast<std::uint8_t>((x + 0x80U + (x >> 8U)) >> 8U);
+  };
+  return {mul(c.r), mul(c.g), mul(c.b), mul(c.a)};
+}
+
+/// Maps destination pixels to source pixels along one axis using 16.16 fixed point. The position of pixel n is that
+/// of its center so that the source is sampled symmetrically whether it is enlarged or reduced.
+class scale_axis {
+public:
+  /// \param src_size  The number of source pixels along this axis.
+  /// \param dest_start  The destination ordinate corresponding to the first source pixel.
+  /// \param dest_size  The number of destination pixels spanned by the source.
+  constexpr scale_axis(unsigned const src_size, int const dest_start, unsigned const dest_size) noexcept
+      : src_size_{src_size},
+        dest_start_{dest_start},
+        step_{(static_cast<std::int64_t>(src_size) << 16) / dest_size} {}
+
+  /// \returns The 16.16 source position of the center of destination pixel \p d.
+  [[nodiscard]] constexpr std::int64_t position(int const d) const noexcept {
+    return step_ / 2 + (d - dest_start_) * step_;
+  }
+  /// \returns The source pixel nearest to the center of destination pixel \p d.
+  [[nodiscard]] constexpr unsigned nearest(int const d) const noexcept {
+    return static_cast<unsigned>(std::min(position(d) >> 16, static_cast<std::int64_t>(src_size_) - 1));
+  }
+  /// A pair of adjacent source pixels and the weight (in 256ths) of the second.
+  struct sample {
+    unsigned first;
+    unsigned second;
+    std::uint16_t weight;
+  };
+  /// \returns The two source pixels between which the center of destination pixel \p d lies. They are clamped to
+  ///   the source's edges.
+  [[nodiscard]] constexpr sample linear(int const d) const noexcept {
+    auto const pos = position(d) - 0x8000;  // Relative to the centers of the source pixels.
+    auto const last = static_cast<std::int64_t>(src_size_) - 1;
+    if (pos <= 0) {
+      return {.first = 0U, .second = 0U, .weight = 0U};
+    }
+    if ((pos >> 16) >= last) {
+      return {.first = static_cast<unsigned>(last), .second = static_cast<unsigned>(last), .weight = 0U};
+    }
+    auto const first = static_cast<unsigned>(pos >> 16);
+    return {.first = first, .second = first + 1U, .weight = static_cast<std::uint16_t>((pos >> 8) & 0xFF)};
   }
-  // Clamp x1 to the bitmap's right edge.
-  x1 = std::min(x1, width_ - 1U);
-  auto it = store_.begin();
-  std::advance(it, (y * stride_) + x0);
-  assert(it < store_.end() && "iterator is not within the bitmap");
 
-  this->mark_dirty({.top = static_cast<coordinate>(y),
-                    .left = static_cast<coordinate>(x0),
-                    .bottom = static_cast<coordinate>(y),
-                    .right = static_cast<coordinate>(x1)});
+private:
+  unsigned src_size_;
+  int dest_start_;
+  std::int64_t step_;
+};
+
+/// The number of destination columns processed together by operations, such as copy_scaled() and paint_gradient(),
+/// that generate a row of source pixels before passing it to a row kernel. Rows of this size live on the stack so
+/// that no allocation is required.
+constexpr auto chunk_size = 64U;
+using chunk_row = std::array<draw::rgba_premult, chunk_size>;
 
-  for (auto x = x0; x <= x1; ++x, ++it) {
-    assert(it < store_.end() && "iterator is not within the bitmap");
-    auto const mask = std::byte{1} << (x % 8U);
-    if ((pattern & mask) != std::byte{0}) {
-      it->composite(color);
+/// Interpolates between pairs of pixels of a source row, four destination pixels at a time.
+///
+/// \param out  The row of interpolated pixels.
+/// \param src_row  The first pixel of the source row.
+/// \param samples  The source pixels and weights for each destination pixel.
+/// \param count  The number of destination pixels.
+void lerp_horizontal(chunk_row& out, draw::rgba_premult const* DRAW_NONNULL src_row,
+                     std::span<scale_axis::sample const> const samples, std::size_t const count) noexcept {
+  namespace details = draw::details;
+  for (auto x = std::size_t{0}; x < count; x += 4U) {
+    std::array<draw::rgba_premult, 4> a{};
+    std::array<draw::rgba_premult, 4> b{};
+    std::array<std::uint16_t, 16> weights{};
+    for (auto lane = std::size_t{0}; lane < 4U && x + lane < count; ++lane) {
+      auto const& s = samples[x + lane];
+      a[lane] = src_row[s.first];
+      b[lane] = src_row[s.second];
+      std::fill_n(&weights[lane * 4U], 4U, s.weight);
     }
+    auto const pa = details::load4(a.data());
+    auto const pb = details::load4(b.data());
+    auto const lo = details::lerp8(details::widen_lo(pa), details::widen_lo(pb), details::load16(&weights[0]));
+    auto const hi = details::lerp8(details::widen_hi(pa), details::widen_hi(pb), details::load16(&weights[8]));
+    details::store4(&out[x], details::narrow(lo, hi));
   }
 }
 
-void bitmap32::line_vertical(unsigned const x, unsigned y0, unsigned y1, rgba_premult const& color) {
-  using namespace draw::literals;
-  if (x >= width_) {
-    return;
+/// Interpolates between two rows of pixels with a single weight (in 256ths) for the second.
+void lerp_vertical(chunk_row& out, chunk_row const& a, chunk_row const& b, std::uint16_t const weight,
+                   std::size_t const count) noexcept {
+  namespace details = draw::details;
+  auto const f = details::splat8(weight);
+  for (auto x = std::size_t{0}; x < count; x += 4U) {
+    auto const pa = details::load4(&a[x]);
+    auto const pb = details::load4(&b[x]);
+    details::store4(&out[x], details::narrow(details::lerp8(details::widen_lo(pa), details::widen_lo(pb), f),
+                                             details::lerp8(details::widen_hi(pa), details::widen_hi(pb), f)));
+  }
+}
+
+/// The number of distinct colors in a gradient.
+constexpr auto ramp_size = 256U;
+using color_ramp = std::array<draw::rgba_premult, ramp_size>;
+
+/// Interpolates the colors of a gradient's stops to give a color for each position.
+color_ramp make_ramp(std::span<draw::bitmap32::gradient_stop const> const stops) noexcept {
+  assert(!stops.empty() && "a gradient needs at least one stop");
+  assert(std::ranges::is_sorted(stops, {}, &draw::bitmap32::gradient_stop::position) && "stops must be sorted");
+  color_ramp ramp{};
+  auto const& first = stops.front();
+  std::fill_n(ramp.begin(), first.position, draw::rgba_premult{first.color});
+  // The colors are interpolated after premultiplication so that translucent stops do not produce dark fringes.
+  for (auto stop = std::size_t{1}; stop < stops.size(); ++stop) {
+    auto const& from = stops[stop - 1U];
+    auto const& to = stops[stop];
+    auto const a = draw::rgba_premult{from.color};
+    auto const b = draw::rgba_premult{to.color};
+    auto const span = static_cast<unsigned>(to.position - from.position);
+    auto const lerp = [span](std::uint8_t const ca, std::uint8_t const cb, unsigned const n) {
+      return static_cast<std::uint8_t>((ca * (span - n) + cb * n + span / 2U) / span);
+    };
+    for (auto n = 0U; n < span; ++n) {
+      ramp[from.position + n] = draw::rgba_premult{lerp(a.r, b.r, n), lerp(a.g, b.g, n), lerp(a.b, b.b, n),
+                                                   lerp(a.a, b.a, n)};
+    }
+  }
+  auto const& last = stops.back();
+  std::fill(ramp.begin() + last.position, ramp.end(), draw::rgba_premult{last.color});
+  return ramp;
+}
+
+/// The quotient and remainder of a division rounding towards negative infinity.
+struct floor_division {
+  constexpr floor_division(std::int64_t const numerator, std::int64_t const denominator) noexcept
+      : quotient{numerator / denominator}, remainder{numerator % denominator} {
+    if (remainder < 0) {
+      --quotient;
+      remainder += denominator;
+    }
+  }
+  std::int64_t quotient;
+  std::int64_t remainder;
+};
+
+/// Computes the ramp indices of a run of pixels of a linear gradient. The index of a pixel is the floor of 255 times
+/// its projection onto the gradient divided by the gradient's squared length. It is advanced from pixel to pixel by
+/// a constant whole and fractional increment with the fraction held exactly as a remainder (as in Bresenham's line
+/// algorithm) so that stepping never drifts from the exact value and there is no division per pixel.
+class linear_stepper {
+public:
+  linear_stepper(draw::point const start, draw::point const end) noexcept
+      : start_{start},
+        dx_{end.x - start.x},
+        dy_{end.y - start.y},
+        length2_{static_cast<std::int64_t>(dx_) * dx_ + static_cast<std::int64_t>(dy_) * dy_},
+        step_{static_cast<std::int64_t>(dx_) * (ramp_size - 1U), std::max(length2_, std::int64_t{1})} {}
+
+  void operator()(std::span<std::uint8_t> const out, int const x, int const y) const noexcept {
+    if (length2_ == 0) {
+      std::ranges::fill(out, std::uint8_t{ramp_size - 1U});
+      return;
+    }
+    auto const projection =
+        static_cast<std::int64_t>(x - start_.x) * dx_ + static_cast<std::int64_t>(y - start_.y) * dy_;
+    auto t = floor_division{projection * (ramp_size - 1U), length2_};
+    for (auto& index : out) {
+      index = static_cast<std::uint8_t>(std::clamp(t.quotient, std::int64_t{0}, std::int64_t{ramp_size - 1U}));
+      t.quotient += step_.quotient;
+      t.remainder += step_.remainder;
+      if (t.remainder >= length2_) {
+        t.remainder -= length2_;
+        ++t.quotient;
+      }
+    }
   }
-  if (y0 > y1) {
-    std::swap(y0, y1);
+
+private:
+  draw::point start_;
+  int dx_;
+  int dy_;
+  std::int64_t length2_;
+  floor_division step_;
+};
+
+/// Computes the ramp indices of a run of pixels of a radial gradient. The index of a pixel at distance d from the
+/// center is floor(255 * d / radius). Both the squared distance and the index are tracked incrementally: moving one
+/// pixel changes the squared distance by 2 * dx + 1 and the index by a small amount, so no square root is needed
+/// beyond the first pixel of each run.
+class radial_stepper {
+public:
+  radial_stepper(draw::point const center, draw::point const edge) noexcept
+      : center_{center},
+        radius2_{static_cast<std::int64_t>(edge.x - center.x) * (edge.x - center.x) +
+                 static_cast<std::int64_t>(edge.y - center.y) * (edge.y - center.y)} {}
+
+  void operator()(std::span<std::uint8_t> const out, int const x, int const y) const noexcept {
+    if (radius2_ == 0) {
+      std::ranges::fill(out, std::uint8_t{ramp_size - 1U});
+      return;
+    }
+    constexpr auto scale2 = std::int64_t{(ramp_size - 1U) * (ramp_size - 1U)};
+    auto dx = static_cast<std::int64_t>(x - center_.x);
+    auto const dy = static_cast<std::int64_t>(y - center_.y);
+    auto distance2 = dx * dx + dy * dy;
+    auto index = static_cast<std::int64_t>(
+        std::min(std::sqrt(static_cast<double>(distance2 * scale2) / static_cast<double>(radius2_)),
+                 static_cast<double>(ramp_size - 1U)));
+    for (auto& v : out) {
+      // Correct the index so that index^2 * radius^2 <= distance^2 * 255^2 < (index + 1)^2 * radius^2.
+      auto const target = distance2 * scale2;
+      while (index < ramp_size - 1U && (index + 1) * (index + 1) * radius2_ <= target) {
+        ++index;
+      }
+      while (index > 0 && index * index * radius2_ > target) {
+        --index;
+      }
+      v = static_cast<std::uint8_t>(index);
+      distance2 += 2 * dx + 1;
+      ++dx;
+    }
+  }
+
+private:
+  draw::point center_;
+  std::int64_t radius2_;
+};
+
+}  // end anonymous namespace
+
+namespace draw {
+
+void bitmap32::copy(bitmap32 const& source, point const dest_pos, transfer_mode const mode) {
+  // An initial gross clipping check.
+  if ((dest_pos.x >= static_cast<int>(width_)) || (dest_pos.x + static_cast<int>(source.width()) < 0) ||
+      (dest_pos.y >= static_cast<int>(height_)) || (dest_pos.y + static_cast<int>(source.height()) < 0)) {
+    return;
   }
-  if (y0 >= height_) {
+
+  auto dest_y = static_cast<unsigned>(std::max(dest_pos.y, coordinate{0}));
+  auto const dirty_top = dest_y;
+
+  auto const src_y_init = dest_pos.y < 0 ? static_cast<unsigned>(-dest_pos.y) : 0U;
+  auto const src_y_end = std::min(static_cast<unsigned>(source.height_), src_y_init + height_ - dest_y);
+
+  auto const src_x_init = dest_pos.x >= 0 ? 0U : static_cast<unsigned>(-dest_pos.x);
+  auto const dest_x = static_cast<unsigned>(std::max(dest_pos.x, coordinate{0}));
+  auto const src_x_end = std::min(static_cast<unsigned>(source.width_), src_x_init + width_ - dest_x);
+  if (src_x_init >= src_x_end || src_y_init >= src_y_end) {
     return;
   }
-  y1 = std::min(y1 + 1U, static_cast<unsigned>(height_));
-  assert(y0 < y1);
 
-  auto index = y0 * stride_ + x;
-  for (auto y = y0; y < y1; ++y) {
-    assert(index < store_.size() && "index is not within the bitmap");
-    store_[index].composite(color);
-    index += stride_;
+  // Select the kernel once so that the inner loop doesn't need to dispatch on the transfer mode.
+  row_kernel const kernel = get_row_kernel(mode);
+  for (auto src_y = src_y_init; src_y < src_y_end; ++src_y, ++dest_y) {
+    kernel(&store_[dest_y * stride_ + dest_x], &source.store_[src_y * source.stride_ + src_x_init],
+           src_x_end - src_x_init);
   }
 
-  this->mark_dirty({.top = static_cast<coordinate>(y0),
-                    .left = static_cast<coordinate>(x),
-                    .bottom = static_cast<coordinate>(y1 - 1U),
-                    .right = static_cast<coordinate>(x)});
+  this->mark_dirty({.top = static_cast<coordinate>(dirty_top),
+                    .left = static_cast<coordinate>(dest_x),
+                    .bottom = static_cast<coordinate>(dest_y - 1U),
+                    .right = static_cast<coordinate>(dest_x + src_x_end - src_x_init - 1U)});
 }
 
-void bitmap32::line(point p0, point p1, rgba const& color) {
-  using namespace draw::literals;
-  auto const colorpm = rgba_premult{color};
-  if (p0.y == p1.y) {
-    if (p0.y >= 0 && p0.y < height_) {
-      this->line_horizontal(static_cast<std::uint16_t>(std::max(p0.x, coordinate{0})),
-                            static_cast<std::uint16_t>(std::max(p1.x, coordinate{0})), static_cast<std::uint16_t>(p0.y),
-                            colorpm, 0xFF_b);
-    }
+void bitmap32::copy_keyed(bitmap32 const& source, point const dest_pos, rgba const& key) {
+  auto const area = this->clip_blit(source.bounds(), source.width(), source.height(), dest_pos);
+  if (!area) {
     return;
   }
-  if (p0.x == p1.x) {
-    if (p0.x >= 0 && p0.x < width_) {
-      this->line_vertical(static_cast<unsigned>(p0.x), static_cast<unsigned>(std::max(p0.y, coordinate{0})),
-                          static_cast<unsigned>(std::max(p1.y, coordinate{0})), colorpm);
+  auto const k = rgba_premult{key};
+  for (auto y = 0U; y < area->height; ++y) {
+    details::keyed_row(&store_[(area->dest_y + y) * stride_ + area->dest_x],
+                       &source.store_[(area->src_y + y) * source.stride_ + area->src_x], area->width, k);
+  }
+  this->mark_dirty(*area);
+}
+
+void bitmap32::line_aa(point p0, point p1, rgba const& color) {
+  auto const dx = std::abs(static_cast<int>(p1.x) - static_cast<int>(p0.x));
+  auto const dy = std::abs(static_cast<int>(p1.y) - static_cast<int>(p0.y));
+  if (dx == 0 || dy == 0 || dx == dy) {
+    // These lines pass through the centre of every pixel that they touch.
+    basic_bitmap::line(p0, p1, rgba_premult{color});
+    return;
+  }
+
+  // Work in (major, minor) coordinates so that a single loop serves both orientations. The major axis is the one
+  // along which the line is longer: x for a shallow line, y for a steep one.
+  bool const steep = dy > dx;
+  if (steep) {
+    std::swap(p0.x, p0.y);
+    std::swap(p1.x, p1.y);
+  }
+  if (p0.x > p1.x) {
+    std::swap(p0, p1);
+  }
+  auto const major_extent = static_cast<int>(steep ? height_ : width_);
+  auto const minor_extent = static_cast<int>(steep ? width_ : height_);
+
+  auto const c = rgba_premult{color};
+  std::optional<rect> modified;
+  auto const plot = [this, steep, &c, &modified](int const major, int const minor, unsigned const coverage) {
+    auto const x = steep ? minor : major;
+    auto const y = steep ? major : minor;
+    if (coverage == 0U || x < 0 || y < 0 || x >= static_cast<int>(width_) || y >= static_cast<int>(height_)) {
+      return;
     }
+    store_[static_cast<std::size_t>(y) * stride_ + static_cast<std::size_t>(x)].composite(scale(c, coverage));
+    auto const r = rect{.top = static_cast<coordinate>(y),
+                        .left = static_cast<coordinate>(x),
+                        .bottom = static_cast<coordinate>(y),
+                        .right = static_cast<coordinate>(x)};
+    modified = modified ? modified->union_rect(r) : r;
+  };
+
+  // The end points lie exactly on the line.
+  plot(p0.x, p0.y, 0xFFU);
+  plot(p1.x, p1.y, 0xFFU);
+
+  // After i steps along the major axis, the line has moved (i * adjust) / 2^16 pixels along the minor axis. The
+  // integer part selects the first of the two pixels that straddle the line and the top 8 bits of the fraction give
+  // the coverage of the second.
+  auto const d_major = static_cast<int>(p1.x) - static_cast<int>(p0.x);
+  auto const d_minor = static_cast<int>(p1.y) - static_cast<int>(p0.y);
+  auto const minor_step = d_minor < 0 ? -1 : 1;
+  auto const adjust = (static_cast<std::uint64_t>(std::abs(d_minor)) << 16U) / static_cast<std::uint64_t>(d_major);
+  assert(adjust > 0U && adjust < (std::uint64_t{1} << 16U));
+
+  // Clip analytically rather than testing every pixel: find the steps for which the major ordinate lies within the
+  // bitmap and then those for which at least one of the pair of pixels lies within it along the minor axis.
+  auto first = std::max(1, -static_cast<int>(p0.x));
+  auto last = std::min(d_major - 1, major_extent - 1 - static_cast<int>(p0.x));
+  auto const k_min = minor_step > 0 ? -static_cast<int>(p0.y) - 1 : static_cast<int>(p0.y) - minor_extent;
+  auto const k_max = minor_step > 0 ? minor_extent - 1 - static_cast<int>(p0.y) : static_cast<int>(p0.y);
+  if (k_min > 0) {
+    auto const k = static_cast<std::uint64_t>(k_min) << 16U;
+    first = std::max(first, static_cast<int>(std::min((k + adjust - 1U) / adjust, std::uint64_t{0x7FFF'FFFF})));
+  }
+  if (k_max < 0) {
+    last = 0;  // The line lies wholly beyond the bitmap along the minor axis.
+  } else {
+    auto const k_end = (static_cast<std::uint64_t>(k_max) + 1U) << 16U;
+    last = std::min(last, static_cast<int>(std::min((k_end - 1U) / adjust, std::uint64_t{0x7FFF'FFFF})));
+  }
+
+  auto total = static_cast<std::uint64_t>(first) * adjust;
+  for (auto i = first; i <= last; ++i, total += adjust) {
+    auto const minor = static_cast<int>(p0.y) + minor_step * static_cast<int>(total >> 16U);
+    auto const weight = static_cast<unsigned>((total >> 8U) & 0xFFU);
+    plot(static_cast<int>(p0.x) + i, minor, 0xFFU - weight);
+    plot(static_cast<int>(p0.x) + i, minor + minor_step, weight);
+  }
+  if (modified) {
+    this->mark_dirty(*modified);
+  }
+}
+
+void bitmap32::copy_scaled(bitmap32 const& source, rect const& dest_rect, scale_filter const filter,
+                           transfer_mode const mode) {
+  if (dest_rect.right < dest_rect.left || dest_rect.bottom < dest_rect.top || source.width() == 0U ||
+      source.height() == 0U) {
     return;
   }
+  // Clip to this bitmap. The mapping from destination to source remains relative to the unclipped rectangle.
+  auto const left = std::max(static_cast<int>(dest_rect.left), 0);
+  auto const top = std::max(static_cast<int>(dest_rect.top), 0);
+  auto const right = std::min(static_cast<int>(dest_rect.right), static_cast<int>(width_) - 1);
+  auto const bottom = std::min(static_cast<int>(dest_rect.bottom), static_cast<int>(height_) - 1);
+  if (left > right || top > bottom) {
+    return;
+  }
+  auto const x_axis = scale_axis{source.width(), dest_rect.left,
+                                 static_cast<unsigned>(static_cast<int>(dest_rect.right) - dest_rect.left + 1)};
+  auto const y_axis = scale_axis{source.height(), dest_rect.top,
+                                 static_cast<unsigned>(static_cast<int>(dest_rect.bottom) - dest_rect.top + 1)};
+  row_kernel const kernel = get_row_kernel(mode);
+  auto const src_row = [&source](unsigned const y) { return &source.store_[y * source.stride_]; };
 
-  auto const sx = p0.x < p1.x ? coordinate{1} : coordinate{-1};
-  auto const sy = p0.y < p1.y ? coordinate{1} : coordinate{-1};
-  auto const dx = std::abs(static_cast<int>(p1.x) - static_cast<int>(p0.x));
-  auto const dy = -std::abs(static_cast<int>(p1.y) - static_cast<int>(p0.y));
-  auto err = dx + dy;
-
-  for (;;) {
-    this->set({.x = p0.x, .y = p0.y}, colorpm);
-    auto const e2 = err * 2;
-    if (e2 >= dy) {
-      if (p0.x == p1.x) {
-        break;
+  // The destination is processed in vertical strips so that the intermediate rows fit on the stack.
+  for (auto x0 = left; x0 <= right; x0 += static_cast<int>(chunk_size)) {
+    auto const count = static_cast<std::size_t>(std::min(right - x0 + 1, static_cast<int>(chunk_size)));
+    chunk_row out{};
+    if (filter == scale_filter::nearest) {
+      std::array<unsigned, chunk_size> columns{};
+      for (auto x = std::size_t{0}; x < count; ++x) {
+        columns[x] = x_axis.nearest(x0 + static_cast<int>(x));
+      }
+      for (auto y = top; y <= bottom; ++y) {
+        auto const* const row = src_row(y_axis.nearest(y));
+        std::ranges::transform(std::span{columns}.first(count), out.begin(), [row](unsigned c) { return row[c]; });
+        kernel(&store_[static_cast<std::size_t>(y) * stride_ + static_cast<std::size_t>(x0)], out.data(), count);
       }
-      err += dy;
-      p0.x += sx;
+      continue;
     }
 
-    if (e2 <= dx) {
-      if (p0.y == p1.y) {
-        break;
+    std::array<scale_axis::sample, chunk_size> columns{};
+    for (auto x = std::size_t{0}; x < count; ++x) {
+      columns[x] = x_axis.linear(x0 + static_cast<int>(x));
+    }
+    // A cache of two horizontally interpolated source rows. When enlarging, successive destination rows usually lie
+    // between the same pair of source rows so each is interpolated only once.
+    std::array<chunk_row, 2> cache{};
+    std::array<std::optional<unsigned>, 2> cached_row{};
+    auto const fetch = [&](unsigned const sy, unsigned const keep) -> chunk_row const& {
+      for (auto slot = 0U; slot < 2U; ++slot) {
+        if (cached_row[slot] == sy) {
+          return cache[slot];
+        }
       }
-      err += dx;
-      p0.y += sy;
+      // Replace the slot that isn't holding the other row needed for this destination row.
+      auto const slot = cached_row[0] == keep ? 1U : 0U;
+      lerp_horizontal(cache[slot], src_row(sy), columns, count);
+      cached_row[slot] = sy;
+      return cache[slot];
+    };
+    for (auto y = top; y <= bottom; ++y) {
+      auto const sample = y_axis.linear(y);
+      chunk_row const& a = fetch(sample.first, sample.second);
+      chunk_row const& b = fetch(sample.second, sample.first);
+      lerp_vertical(out, a, b, sample.weight, count);
+      kernel(&store_[static_cast<std::size_t>(y) * stride_ + static_cast<std::size_t>(x0)], out.data(), count);
     }
   }
+
+  this->mark_dirty({.top = static_cast<coordinate>(top),
+                    .left = static_cast<coordinate>(left),
+                    .bottom = static_cast<coordinate>(bottom),
+                    .right = static_cast<coordinate>(right)});
+}
+
+void bitmap32::paint_gradient(rect const& r, std::span<gradient_stop const> const stops, gradient_kind const kind,
+                              point const start, point const end, transfer_mode const mode) {
+  // Clipping the area as a transfer to itself limits it to the bounds of the bitmap.
+  auto const area = this->clip_blit(r, width_, height_, r.top_left());
+  if (!area) {
+    return;
+  }
+  auto const ramp = make_ramp(stops);
+  row_kernel const kernel = get_row_kernel(mode);
+  auto const paint = [&](auto const& stepper) {
+    std::array<std::uint8_t, chunk_size> indices{};
+    chunk_row out{};
+    for (auto y = area->dest_y; y < area->dest_y + area->height; ++y) {
+      auto* const row = &store_[static_cast<std::size_t>(y) * stride_];
+      for (auto x = area->dest_x; x < area->dest_x + area->width; x += chunk_size) {
+        auto const count = std::min(std::size_t{chunk_size}, std::size_t{area->dest_x + area->width - x});
+        auto const run = std::span{indices}.first(count);
+        stepper(run, static_cast<int>(x), static_cast<int>(y));
+        std::ranges::transform(run, out.begin(), [&ramp](std::uint8_t const index) { return ramp[index]; });
+        kernel(row + x, out.data(), count);
+      }
+    }
+  };
+  switch (kind) {
+  case gradient_kind::linear: paint(linear_stepper{start, end}); break;
+  case gradient_kind::radial: paint(radial_stepper{start, end}); break;
+  }
+  this->mark_dirty(*area);
+}
+
+void rgba_premult_format::span(storage_type* const DRAW_NONNULL row, unsigned const x0, unsigned const x1,
+                               std::byte const pattern, value_type const& fg,
+                               std::optional<value_type> const& bg) noexcept {
+  assert(x0 <= x1);
+  auto const mask = pattern_mask(pattern, x0);
+  details::composite_span(row + x0, x1 - x0 + 1U, fg, mask);
+  if (bg && pattern != std::byte{0xFF}) {
+    details::composite_span(row + x0, x1 - x0 + 1U, *bg, pattern_mask(~pattern, x0));
+  }
+}
+
+void bitmap32::expand(bitmap const& source, rect const& src_rect, point const dest_pos, rgba const& fg,
+                      rgba const& bg) {
+  this->expand_mask(source, src_rect, dest_pos, rgba_premult{fg}, rgba_premult{bg});
+}
+
+void bitmap32::expand(bitmap const& source, rect const& src_rect, point const dest_pos, rgba const& fg) {
+  this->expand_mask(source, src_rect, dest_pos, rgba_premult{fg}, std::nullopt);
+}
+
+void bitmap32::expand_mask(bitmap const& mask, rect const& src_rect, point const dest_pos, rgba_premult const& fg,
+                           std::optional<rgba_premult> const& bg) {
+  auto const area = this->clip_blit(src_rect, mask.width(), mask.height(), dest_pos);
+  if (!area) {
+    return;
+  }
+  auto const src_store = mask.store();
+  auto* dest = &store_[static_cast<std::size_t>(area->dest_y) * stride_ + area->dest_x];
+  for (auto src_y = area->src_y; src_y < area->src_y + area->height; ++src_y) {
+    auto const src_row = src_store.subspan(static_cast<std::size_t>(src_y) * mask.stride(), mask.stride());
+    if (bg) {
+      details::expand_bits(dest, area->width, src_row, area->src_x, fg, *bg);
+    } else {
+      details::composite_bits(dest, area->width, src_row, area->src_x, fg);
+    }
+    dest += stride_;
+  }
+  this->mark_dirty(*area);
+}
+
+void bitmap32::fill_mask(alpha8 const& mask, point const dest_pos, rgba const& color) {
+  auto const area = this->clip_blit(mask.bounds(), mask.width(), mask.height(), dest_pos);
+  if (!area) {
+    return;
+  }
+  auto const c = rgba_premult{color};
+  auto const src_store = mask.store();
+  for (auto y = 0U; y < area->height; ++y) {
+    details::composite_coverage(&store_[(area->dest_y + y) * stride_ + area->dest_x], area->width,
+                                &src_store[(area->src_y + y) * mask.stride() + area->src_x], c);
+  }
+  this->mark_dirty(*area);
+}
+
+void bitmap32::box_blur(rect const& r, unsigned const radius, unsigned const passes) {
+  assert(radius <= max_blur_radius && "radius is too great");
+  // Clipping the area as a transfer to itself limits it to the bounds of the bitmap.
+  auto const area = this->clip_blit(r, width_, height_, r.top_left());
+  if (!area || radius == 0U || passes == 0U) {
+    return;
+  }
+  // The channels are blurred independently so each pixel is treated as four bytes.
+  static_assert(sizeof(rgba_premult) == 4U);
+  details::box_blur<sizeof(rgba_premult)>(
+      reinterpret_cast<std::uint8_t*>(&store_[static_cast<std::size_t>(area->dest_y) * stride_ + area->dest_x]),
+      std::size_t{stride_} * sizeof(rgba_premult), area->width, area->height, radius, passes);
+  this->mark_dirty(*area);
+}
+
+void bitmap32::drop_shadow(bitmap32 const& layer, point const dest_pos, point const offset, unsigned const radius,
+                           rgba const& color, alpha8& scratch) {
+  auto const margin = shadow_margin(radius);
+  auto const width = layer.width() + 2U * margin;
+  auto const height = layer.height() + 2U * margin;
+  assert(scratch.width() >= width && scratch.height() >= height && "scratch mask is too small");
+  alpha8 shadow{scratch.store(), static_cast<std::uint16_t>(width), static_cast<std::uint16_t>(height),
+                scratch.stride()};
+
+  // The shadow starts as the alpha of the layer surrounded by a transparent margin into which the blur spreads.
+  auto const dest = shadow.store();
+  auto const src = layer.store();
+  for (auto y = 0U; y < height; ++y) {
+    auto const row = dest.subspan(static_cast<std::size_t>(y) * shadow.stride(), width);
+    std::ranges::fill(row, std::uint8_t{0});
+    if (y >= margin && y < margin + layer.height()) {
+      auto const src_row = src.subspan(static_cast<std::size_t>(y - margin) * layer.stride(), layer.width());
+      std::ranges::transform(src_row, row.begin() + margin, [](rgba_premult const& px) { return px.a; });
+    }
+  }
+  shadow.box_blur(shadow.bounds(), radius, shadow_passes);
+  this->fill_mask(shadow,
+                  point{.x = static_cast<coordinate>(dest_pos.x + offset.x - static_cast<int>(margin)),
+                        .y = static_cast<coordinate>(dest_pos.y + offset.y - static_cast<int>(margin))},
+                  color);
+  this->copy(layer, dest_pos, transfer_mode::mode_src_over);
+}
+
+std::uint16_t bitmap32::char_width(font const& f, char32_t const code_point) {
+  return bitmap::char_width(f, code_point);
+}
+
+void bitmap32::draw_char(glyph_source& gc, font const& f, char32_t const code_point, point const pos,
+                         rgba const& color) {
+  if (pos.x > this->width() || pos.y > this->height()) {
+    return;
+  }
+  bitmap const& glyph = gc.get(f, code_point);
+  this->expand_mask(glyph, glyph.bounds(), pos, rgba_premult{color}, std::nullopt);
+}
+
+point bitmap32::draw_string(glyph_source& gc, font const& f, std::u8string_view s, point pos, rgba const& color) {
+  coordinate const new_x = scan_string(f, s, [this, &gc, &f, &pos, &color](char32_t code_point, coordinate x) {
+    this->draw_char(gc, f, code_point, {.x = static_cast<coordinate>(pos.x + x), .y = pos.y}, color);
+  });
+  return {.x = static_cast<coordinate>(pos.x + new_x), .y = pos.y};
 }
 
 }  // end namespace draw
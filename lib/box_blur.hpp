@@ -0,0 +1,157 @@
+//===- lib/box_blur.hpp -----------------------------------*- mode: C++ -*-===//
+//*  _                 _     _             *
+//* | |__   _____  __ | |__ | |_   _ _ __  *
+//* | '_ \ / _ \ \/ / | '_ \| | | | | '__| *
+//* | |_) | (_) >  <  | |_) | | |_| | |    *
+//* |_.__/ \___/_/\_\ |_.__/|_|\__,_|_|    *
+//*                                        *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+/// \file box_blur.hpp
+/// \brief Separable sliding-window box blur shared by alpha8 and bitmap32.
+///
+/// Each pass keeps a running sum of the window around the current pixel: moving along a line adds the value entering
+/// the window and subtracts the one leaving it, so the cost per pixel is independent of the radius. Lines are
+/// blurred in place; the original values that are still needed once they have been overwritten are held in a small
+/// ring buffer.
+///
+/// The vertical pass processes a strip of adjacent columns together. Its running sums are then a contiguous array
+/// updated by simple loops over whole rows which the compiler vectorizes.
+
+#ifndef DRAW_BOX_BLUR_HPP
+#define DRAW_BOX_BLUR_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "draw/alpha8.hpp"
+
+namespace draw::details {
+
+/// Divides a window sum by the number of values in the window, rounding to nearest. The division is replaced by a
+/// multiplication with a 24-bit reciprocal which is exact for every window sum when the radius does not exceed
+/// max_blur_radius.
+class box_divisor {
+public:
+  constexpr explicit box_divisor(unsigned const radius) noexcept
+      : mul_{((1U << 24) + radius) / (2U * radius + 1U)} {}
+  [[nodiscard]] constexpr std::uint8_t operator()(std::uint32_t const sum) const noexcept {
+    return static_cast<std::uint8_t>((sum * mul_ + (1U << 23)) >> 24);
+  }
+
+private:
+  std::uint32_t mul_;
+};
+
+/// Applies a box filter along a line of elements, each of which is a group of \p count independent bytes.
+///
+/// \tparam Width  The maximum number of bytes in an element.
+/// \param p  The first byte of the first element of the line.
+/// \param step  The distance in bytes between successive elements.
+/// \param length  The number of elements in the line.
+/// \param radius  The number of elements either side of each element that contribute to its value.
+/// \param count  The number of bytes in each element (not more than \p Width).
+/// \param div  Divides a window sum by the number of elements in the window.
+template <std::size_t Width>
+void box_line(std::uint8_t* const DRAW_NONNULL p, std::size_t const step, unsigned const length,
+              unsigned const radius, std::size_t const count, box_divisor const div) noexcept {
+  assert(count <= Width && "element is too large");
+  assert(radius > 0U && radius <= max_blur_radius && "radius is out of range");
+  using element = std::array<std::uint8_t, Width>;
+  auto const last = length - 1U;
+  auto const at = [p, step](unsigned const n) { return p + static_cast<std::size_t>(n) * step; };
+
+  // Values beyond the ends of the line are those of the end elements.
+  element first{};
+  std::copy_n(at(0U), count, first.begin());
+  std::array<std::uint32_t, Width> sum{};
+  for (auto i = std::size_t{0}; i < count; ++i) {
+    sum[i] = first[i] * (radius + 1U);
+  }
+  for (auto n = 1U; n <= radius; ++n) {
+    auto const* const q = at(std::min(n, last));
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      sum[i] += q[i];
+    }
+  }
+
+  // The original values of the last radius + 1 elements. Once element x has been written, the element leaving the
+  // window is x - radius whose original value lies in the slot following that of x.
+  std::array<element, max_blur_radius + 1U> ring;
+  auto slot = 0U;
+  for (auto x = 0U;; ++x) {
+    auto* const q = at(x);
+    std::copy_n(q, count, ring[slot].begin());
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      q[i] = div(sum[i]);
+    }
+    if (x == last) {
+      break;
+    }
+    slot = slot == radius ? 0U : slot + 1U;
+    auto const* const in = at(std::min(x + radius + 1U, last));
+    auto const* const out = x >= radius ? ring[slot].data() : first.data();
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      sum[i] += static_cast<std::uint32_t>(in[i]) - out[i];
+    }
+  }
+}
+
+/// Blurs an area of a bitmap in place with \p passes applications of a separable box filter.
+///
+/// \tparam Channels  The number of bytes in each pixel.
+/// \param origin  The first byte of the top-left pixel of the area.
+/// \param stride  The distance in bytes between successive rows.
+/// \param width  The width of the area in pixels.
+/// \param height  The height of the area in pixels.
+/// \param radius  The number of pixels either side of each pixel that contribute to its value.
+/// \param passes  The number of times that the filter is applied.
+template <std::size_t Channels>
+void box_blur(std::uint8_t* const DRAW_NONNULL origin, std::size_t const stride, unsigned const width,
+              unsigned const height, unsigned const radius, unsigned const passes) noexcept {
+  assert(radius <= max_blur_radius && "radius is too great");
+  if (radius == 0U || width == 0U || height == 0U) {
+    return;
+  }
+  // The number of bytes (adjacent columns) blurred together by the vertical pass.
+  constexpr auto strip = std::size_t{64};
+  auto const div = box_divisor{radius};
+  auto const row_bytes = std::size_t{width} * Channels;
+  for (auto pass = 0U; pass < passes; ++pass) {
+    for (auto y = 0U; y < height; ++y) {
+      box_line<Channels>(origin + y * stride, Channels, width, radius, Channels, div);
+    }
+    for (auto x = std::size_t{0}; x < row_bytes; x += strip) {
+      box_line<strip>(origin + x, stride, height, radius, std::min(strip, row_bytes - x), div);
+    }
+  }
+}
+
+}  // end namespace draw::details
+
+#endif  // DRAW_BOX_BLUR_HPP
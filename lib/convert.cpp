@@ -0,0 +1,211 @@
+//===- lib/convert.cpp ----------------------------------------------------===//
+//*                                _    *
+//*   ___ ___  _ ____   _____ _ __| |_  *
+//*  / __/ _ \| '_ \ \ / / _ \ '__| __| *
+//* | (_| (_) | | | \ V /  __/ |  | |_  *
+//*  \___\___/|_| |_|\_/ \___|_|   \__| *
+//*                                     *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+#include "draw/convert.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+
+// Local includes
+#include "draw/bitmap32.hpp"
+#include "draw/indexed8_bitmap.hpp"
+#include "draw/types.hpp"
+#include "span32.hpp"
+
+namespace {
+
+using draw::pixel_format;
+using draw::rgba_premult;
+namespace details = draw::details;
+
+/// Converts a block of four pixels to the format given by \p Format.
+template <pixel_format Format>
+void convert4(std::byte* const DRAW_NONNULL dest, rgba_premult const* const DRAW_NONNULL src) noexcept {
+  using details::and_words;
+  using details::or_words;
+  using details::shl_words;
+  using details::shr_words;
+  using details::splat_words;
+  auto const v = details::load_words(src);
+  if constexpr (Format == pixel_format::rgb565) {
+    auto const c = or_words(or_words(and_words(shl_words<8>(v), splat_words(0xF800)),
+                                     and_words(shr_words<5>(v), splat_words(0x07E0))),
+                            and_words(shr_words<19>(v), splat_words(0x001F)));
+    // Swap the two bytes so that the most significant is stored first.
+    details::store_bytes16(dest, or_words(shr_words<8>(c), and_words(shl_words<8>(c), splat_words(0xFF00))));
+  } else if constexpr (Format == pixel_format::rgb888) {
+    details::store_bytes24(dest, v);
+  } else if constexpr (Format == pixel_format::bgr888) {
+    details::store_bytes24(dest, or_words(or_words(and_words(shr_words<16>(v), splat_words(0x0000FF)),
+                                                   and_words(v, splat_words(0x00FF00))),
+                                          and_words(shl_words<16>(v), splat_words(0xFF0000))));
+  } else if constexpr (Format == pixel_format::gray8) {
+    details::store_bytes8(dest, details::luma_words(v));
+  } else {
+    static_assert(Format == pixel_format::rgba8888, "unknown pixel format");
+    if (details::all_opaque(v)) {
+      // Opaque pixels are unaffected by premultiplication.
+      std::memcpy(dest, src, 4 * sizeof(rgba_premult));
+      return;
+    }
+    auto* out = dest;
+    for (auto const& px : std::span{src, 4}) {
+      *(out++) = static_cast<std::byte>(details::unpremultiply(px.r, px.a));
+      *(out++) = static_cast<std::byte>(details::unpremultiply(px.g, px.a));
+      *(out++) = static_cast<std::byte>(details::unpremultiply(px.b, px.a));
+      *(out++) = static_cast<std::byte>(px.a);
+    }
+  }
+}
+
+/// Converts a row of \p count pixels to the format given by \p Format.
+template <pixel_format Format>
+void convert_row(std::byte* DRAW_NONNULL dest, rgba_premult const* DRAW_NONNULL src, std::size_t count) noexcept {
+  constexpr auto bpp = draw::bytes_per_pixel(Format);
+  for (; count >= 4U; count -= 4U) {
+    convert4<Format>(dest, src);
+    src += 4;
+    dest += 4 * bpp;
+  }
+  if (count > 0U) {
+    // The final partial block goes via temporaries so that the kernel never touches memory beyond the row.
+    std::array<rgba_premult, 4> s{};
+    std::array<std::byte, 4 * bpp> d{};
+    std::copy_n(src, count, s.begin());
+    convert4<Format>(d.data(), s.data());
+    std::copy_n(d.begin(), count * bpp, dest);
+  }
+}
+
+using row_kernel = void (*)(std::byte* DRAW_NONNULL, rgba_premult const* DRAW_NONNULL, std::size_t) noexcept;
+
+/// Returns the row kernel which produces the pixel format \p format.
+[[nodiscard]] row_kernel get_row_kernel(pixel_format const format) noexcept {
+  switch (format) {
+  case pixel_format::rgb565: return &convert_row<pixel_format::rgb565>;
+  case pixel_format::rgb888: return &convert_row<pixel_format::rgb888>;
+  case pixel_format::bgr888: return &convert_row<pixel_format::bgr888>;
+  case pixel_format::gray8: return &convert_row<pixel_format::gray8>;
+  case pixel_format::rgba8888: return &convert_row<pixel_format::rgba8888>;
+  default: assert(false && "unknown pixel format"); return &convert_row<pixel_format::rgba8888>;
+  }
+}
+
+/// Expands a row of \p count palette indices to big-endian RGB565 four pixels at a time.
+void expand_clut_row(std::byte* DRAW_NONNULL dest, std::uint8_t const* DRAW_NONNULL src, std::size_t count,
+                     draw::clut565 const clut) noexcept {
+  auto const put = [&dest](std::uint16_t const c) {
+    *(dest++) = static_cast<std::byte>(c >> 8U);
+    *(dest++) = static_cast<std::byte>(c & 0xFFU);
+  };
+  for (; count >= 4U; count -= 4U) {
+    auto const c0 = clut[src[0]];
+    auto const c1 = clut[src[1]];
+    auto const c2 = clut[src[2]];
+    auto const c3 = clut[src[3]];
+    put(c0);
+    put(c1);
+    put(c2);
+    put(c3);
+    src += 4;
+  }
+  for (; count > 0U; --count) {
+    put(clut[*(src++)]);
+  }
+}
+
+/// Clips \p area to \p bounds.
+/// \returns The clipped area or std::nullopt if it is empty.
+[[nodiscard]] constexpr std::optional<draw::rect> clip(draw::rect const& area, draw::rect const& bounds) noexcept {
+  auto const r = draw::rect{.top = std::max(area.top, bounds.top),
+                            .left = std::max(area.left, bounds.left),
+                            .bottom = std::min(area.bottom, bounds.bottom),
+                            .right = std::min(area.right, bounds.right)};
+  if (r.top > r.bottom || r.left > r.right) {
+    return std::nullopt;
+  }
+  return r;
+}
+
+}  // end anonymous namespace
+
+namespace draw {
+
+std::span<std::byte> convert(bitmap32 const& source, rect const& area, pixel_format const format,
+                             std::span<std::byte> const dest) noexcept {
+  auto const r = clip(area, source.bounds());
+  if (!r) {
+    return {};
+  }
+  auto const width = static_cast<std::size_t>(r->right - r->left + 1);
+  auto const height = static_cast<std::size_t>(r->bottom - r->top + 1);
+  auto const row_bytes = width * bytes_per_pixel(format);
+  assert(dest.size() >= row_bytes * height && "conversion buffer is too small");
+
+  // Select the kernel once so that the inner loop doesn't need to dispatch on the pixel format.
+  row_kernel const kernel = get_row_kernel(format);
+  auto const store = source.store();
+  auto* out = dest.data();
+  for (auto y = static_cast<std::size_t>(r->top); y <= static_cast<std::size_t>(r->bottom); ++y) {
+    kernel(out, &store[y * source.stride() + static_cast<std::size_t>(r->left)], width);
+    out += row_bytes;
+  }
+  return dest.first(row_bytes * height);
+}
+
+std::span<std::byte> convert(indexed8_bitmap const& source, rect const& area, clut565 const clut,
+                             std::span<std::byte> const dest) noexcept {
+  auto const r = clip(area, source.bounds());
+  if (!r) {
+    return {};
+  }
+  auto const width = static_cast<std::size_t>(r->right - r->left + 1);
+  auto const height = static_cast<std::size_t>(r->bottom - r->top + 1);
+  auto const row_bytes = width * bytes_per_pixel(pixel_format::rgb565);
+  assert(dest.size() >= row_bytes * height && "conversion buffer is too small");
+
+  auto const store = source.store();
+  auto* out = dest.data();
+  for (auto y = static_cast<std::size_t>(r->top); y <= static_cast<std::size_t>(r->bottom); ++y) {
+    expand_clut_row(out, &store[y * source.stride() + static_cast<std::size_t>(r->left)], width, clut);
+    out += row_bytes;
+  }
+  return dest.first(row_bytes * height);
+}
+
+}  // end namespace draw
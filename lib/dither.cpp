@@ -0,0 +1,224 @@
+//===- lib/dither.cpp -----------------------------------------------------===//
+//*      _ _ _   _                *
+//*   __| (_) |_| |__   ___ _ __  *
+//*  / _` | | __| '_ \ / _ \ '__| *
+//* | (_| | | |_| | | |  __/ |    *
+//*  \__,_|_|\__|_| |_|\___|_|    *
+//*                               *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+#include "draw/bitmap.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Local includes
+#include "draw/bitmap32.hpp"
+#include "draw/types.hpp"
+#include "span32.hpp"
+
+namespace {
+
+using draw::rgba_premult;
+namespace details = draw::details;
+
+using threshold_matrix = std::array<std::array<std::uint32_t, 8>, 8>;
+
+/// Builds the threshold matrix for an ordered dither with a Bayer matrix of the given size. The matrix is tiled to
+/// fill 8x8 so that each row supplies the thresholds for one byte of the 1bpp bitmap.
+template <unsigned Size> consteval threshold_matrix make_thresholds() {
+  // Each doubling of the Bayer matrix replaces every element m with the 2x2 block [4m, 4m+2; 4m+3, 4m+1].
+  std::array<std::array<unsigned, 8>, 8> bayer{};
+  for (auto n = 1U; n < Size; n *= 2U) {
+    for (auto y = 0U; y < n; ++y) {
+      for (auto x = 0U; x < n; ++x) {
+        auto const m = 4U * bayer[y][x];
+        bayer[y + n][x + n] = m + 1U;
+        bayer[y][x + n] = m + 2U;
+        bayer[y + n][x] = m + 3U;
+        bayer[y][x] = m;
+      }
+    }
+  }
+  threshold_matrix result{};
+  for (auto y = 0U; y < 8U; ++y) {
+    for (auto x = 0U; x < 8U; ++x) {
+      // Place each threshold at the center of its band of levels.
+      result[y][x] = (bayer[y % Size][x % Size] * 2U + 1U) * 128U / (Size * Size);
+    }
+  }
+  return result;
+}
+
+constexpr auto bayer4 = make_thresholds<4>();
+constexpr auto bayer8 = make_thresholds<8>();
+
+/// Returns the luma of each of four pixels as if composited over white.
+[[nodiscard]] inline details::words4 gray_over_white(rgba_premult const* DRAW_NONNULL src) noexcept {
+  using namespace details;
+  auto const v = load_words(src);
+  return add_words(luma_words(v), shr_words<24>(xor_words(v, splat_words(0xFF000000))));
+}
+/// The scalar equivalent of gray_over_white().
+[[nodiscard]] constexpr int gray_over_white(rgba_premult const& px) noexcept {
+  return static_cast<int>(details::luma(px)) + 0xFF - px.a;
+}
+
+/// Returns a byte in which the bits corresponding to x-ordinates from \p left to \p right (inclusive) that lie within
+/// the byte starting at \p x0 are set.
+[[nodiscard]] constexpr std::uint8_t span_mask(unsigned const x0, unsigned const left, unsigned const right) noexcept {
+  auto const first = std::max(x0, left) - x0;
+  auto const last = std::min(x0 + 7U, right) - x0;
+  return static_cast<std::uint8_t>((0xFFU >> first) & (0xFFU << (7U - last)));
+}
+
+void dither_ordered(draw::bitmap& dest, draw::bitmap32 const& source, draw::rect const& r,
+                    threshold_matrix const& thresholds) noexcept {
+  auto const left = static_cast<unsigned>(r.left);
+  auto const right = static_cast<unsigned>(r.right);
+  auto const src_store = source.store();
+  auto const dest_store = dest.store();
+  for (auto y = static_cast<unsigned>(r.top); y <= static_cast<unsigned>(r.bottom); ++y) {
+    auto const& row_thresholds = thresholds[y % 8U];
+    auto const t0 = details::load_words(row_thresholds.data());
+    auto const t1 = details::load_words(row_thresholds.data() + 4);
+    auto const* const src_row = &src_store[y * source.stride()];
+    for (auto x0 = left & ~7U; x0 <= right; x0 += 8U) {
+      auto const mask = span_mask(x0, left, right);
+      rgba_premult const* src = src_row + x0;
+      std::array<rgba_premult, 8> partial;
+      if (mask != 0xFF) {
+        // The block is only partly inside the area: copy the pixels that are so that nothing outside the source row
+        // is read.
+        auto const first = std::max(x0, left);
+        std::copy(src_row + first, src_row + std::min(x0 + 7U, right) + 1U, partial.begin() + (first - x0));
+        src = partial.data();
+      }
+      auto const bits = (details::less_mask(gray_over_white(src), t0) << 4U) |
+                        details::less_mask(gray_over_white(src + 4), t1);
+      auto& out = dest_store[y * dest.stride() + x0 / 8U];
+      out = (out & ~std::byte{mask}) | (std::byte{static_cast<std::uint8_t>(bits)} & std::byte{mask});
+    }
+  }
+}
+
+template <draw::bitmap::dither_mode Mode>
+void dither_diffuse(draw::bitmap& dest, draw::bitmap32 const& source, draw::rect const& r,
+                    std::span<std::int16_t> const errors) noexcept {
+  auto const left = static_cast<unsigned>(r.left);
+  auto const right = static_cast<unsigned>(r.right);
+  auto const width = right - left + 1U;
+  // e1 holds the errors carried into the current row for pixels yet to be visited and into the next row for those
+  // already visited. Atkinson's method also carries errors two rows down in e2.
+  auto const e1 = errors.first(width);
+  auto const e2 = errors.subspan(width, width);
+  std::ranges::fill(errors.first(draw::bitmap::dither_errors_size(static_cast<std::uint16_t>(width))), 0);
+
+  auto const src_store = source.store();
+  auto const dest_store = dest.store();
+  for (auto y = static_cast<unsigned>(r.top); y <= static_cast<unsigned>(r.bottom); ++y) {
+    auto const* const src_row = &src_store[y * source.stride()];
+    auto* const dest_row = &dest_store[y * dest.stride()];
+    auto carry1 = 0;   // The error carried to the next pixel of this row.
+    auto carry2 = 0;   // The error carried to the pixel after next of this row.
+    auto pending = 0;  // The error carried to the pixel below and right of the previous one.
+    auto bits = 0U;
+    for (auto x = left; x <= right; ++x) {
+      auto const i = x - left;
+      auto const value = gray_over_white(src_row[x]) + e1[i] + carry1;
+      auto const set = value < 0x80;
+      auto const err = value - (set ? 0 : 0xFF);
+      if constexpr (Mode == draw::bitmap::dither_mode::floyd_steinberg) {
+        carry1 = err * 7 / 16;
+        if (i > 0U) {
+          e1[i - 1U] = static_cast<std::int16_t>(e1[i - 1U] + err * 3 / 16);
+        }
+        e1[i] = static_cast<std::int16_t>(pending + err * 5 / 16);
+        pending = err / 16;
+      } else {
+        static_assert(Mode == draw::bitmap::dither_mode::atkinson);
+        auto const e = err / 8;
+        carry1 = carry2 + e;
+        carry2 = e;
+        if (i > 0U) {
+          e1[i - 1U] = static_cast<std::int16_t>(e1[i - 1U] + e);
+        }
+        e1[i] = static_cast<std::int16_t>(e2[i] + pending + e);
+        pending = e;
+        e2[i] = static_cast<std::int16_t>(e);
+      }
+
+      // Gather the output bits and write a byte at a time.
+      bits |= static_cast<unsigned>(set) << (7U - x % 8U);
+      if (x % 8U == 7U || x == right) {
+        auto const x0 = x & ~7U;
+        auto const mask = std::byte{span_mask(x0, left, right)};
+        auto& out = dest_row[x0 / 8U];
+        out = (out & ~mask) | (std::byte{static_cast<std::uint8_t>(bits)} & mask);
+        bits = 0U;
+      }
+    }
+  }
+}
+
+}  // end anonymous namespace
+
+namespace draw {
+
+void bitmap::dither(bitmap32 const& source, rect const& r, dither_mode const mode, std::span<std::int16_t> errors) {
+  auto const clipped = rect{
+      .top = std::max(r.top, coordinate{0}),
+      .left = std::max(r.left, coordinate{0}),
+      .bottom = std::min(r.bottom, static_cast<coordinate>(std::min(height_, source.height()) - 1)),
+      .right = std::min(r.right, static_cast<coordinate>(std::min(width_, source.width()) - 1)),
+  };
+  if (clipped.top > clipped.bottom || clipped.left > clipped.right) {
+    return;
+  }
+
+  switch (mode) {
+  case dither_mode::bayer4: dither_ordered(*this, source, clipped, bayer4); break;
+  case dither_mode::bayer8: dither_ordered(*this, source, clipped, bayer8); break;
+  case dither_mode::floyd_steinberg:
+  case dither_mode::atkinson:
+    assert(errors.size() >= dither_errors_size(static_cast<std::uint16_t>(clipped.right - clipped.left + 1)) &&
+           "error buffer is too small");
+    if (mode == dither_mode::floyd_steinberg) {
+      dither_diffuse<dither_mode::floyd_steinberg>(*this, source, clipped, errors);
+    } else {
+      dither_diffuse<dither_mode::atkinson>(*this, source, clipped, errors);
+    }
+    break;
+  default: assert(false && "unknown dither mode"); break;
+  }
+  this->mark_dirty(clipped);
+}
+
+}  // end namespace draw
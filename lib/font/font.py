@@ -182,6 +182,19 @@ def write_kerning_pairs(source:typing.TextIO, k:int, kdv:KernDictValue) -> None:
     source.write('};\n')
 
 
+def to_row_major(data:Tuple[int, ...], height:int) -> Tuple[int, ...]:
+    """Converts a glyph from columns of 'height' bytes to rows of pixels with each row padded to a whole number of
+    bytes. The most significant bit of each byte holds the left-most pixel."""
+    width = len(data) // height
+    stride = (width + 7) // 8
+    rows = [0] * (stride * height * 8)
+    for x in range(0, width):
+        for y in range(0, height * 8):
+            if data[x * height + y // 8] & (1 << (y % 8)) != 0:
+                rows[y * stride + x // 8] |= 0x80 >> (x % 8)
+    return tuple(rows)
+
+
 def write_bitmap_data(source:typing.TextIO, k:int, data:Tuple[int, ...]) -> None:
     source.write(f'constexpr std::array bitmap_{k:04x} = {{')
     separator = ''
@@ -196,7 +209,8 @@ def write_source_file(input_file:pathlib.Path,
                       kd:KernDict,
                       height:int,
                       output_dir:pathlib.Path,
-                      definition:Dict[str, Any]) -> None:
+                      definition:Dict[str, Any],
+                      row_major:bool) -> None:
     fid = int(definition['id'])
     name:str = definition['name']
     spacing = int(definition['spacing'])
@@ -227,7 +241,7 @@ namespace {data_ns} {{
 
             if not isinstance(v, int):
                 widest = max(widest, len(v) // height)
-                write_bitmap_data(source, k, v)
+                write_bitmap_data(source, k, to_row_major(v, height) if row_major else v)
 
         source.write(f'''
 }} // end namespace {data_ns}
@@ -237,6 +251,7 @@ constexpr font const {name} {{
   .widest={widest},
   .height={height},
   .spacing={spacing},
+  .layout=glyph_layout::{'row_major' if row_major else 'column_major'},
   .glyphs={{
 ''')
         for k, v in font.items():
@@ -246,8 +261,11 @@ constexpr font const {name} {{
 
             # If the value is an integer, this is a reference to a previous glyph.
             bm = v if isinstance(v, int) else k
+            columns = font[bm]
+            assert not isinstance(columns, int)
+            width = len(columns) // height
             kp_name = f'{data_ns}::kern_{k:04x}' if k in kd else 'draw::empty_kern'
-            source.write(f'    {{ {k:#04x}, glyph{{.kerns = decltype(draw::glyph::kerns)::from_array({kp_name}), .bm = decltype(draw::glyph::bm)::from_array({data_ns}::bitmap_{bm:04x})}} }},{kname}\n')
+            source.write(f'    {{ {k:#04x}, glyph{{.kerns = decltype(draw::glyph::kerns)::from_array({kp_name}), .bm = decltype(draw::glyph::bm)::from_array({data_ns}::bitmap_{bm:04x}), .width = {width}}} }},{kname}\n')
         source.write('  }\n};\n')
         source.write('} // end namespace draw\n')
         source.write(f'#endif // {guard}\n')
@@ -328,6 +346,8 @@ def main() -> int:
     parser.add_argument('file', help='JSON metadata describing the input files', type=pathlib.Path)
     parser.add_argument('-o', '--output-dir', help='Output directory', type=pathlib.Path, action=CheckPathAction, default=os.getcwd())
     parser.add_argument('--samples', help='Output samples', action='store_true')
+    parser.add_argument('--layout', help='The arrangement of the glyph bitmap data', choices=['column', 'row'],
+                        default='column')
     args = parser.parse_args()
 
 
@@ -345,7 +365,8 @@ def main() -> int:
                       kern_pairs(definition.get('kern', {})),
                       height,
                       args.output_dir,
-                      definition)
+                      definition,
+                      args.layout == 'row')
     return 0
 
 if __name__ == '__main__':
@@ -30,6 +30,8 @@
 //===----------------------------------------------------------------------===//
 #include "draw/glyph_cache.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -42,6 +44,7 @@
 #include "draw/bitmap.hpp"
 #include "draw/tracer.hpp"
 #include "draw/types.hpp"
+#include "bit_transpose.hpp"
 
 namespace {
 
@@ -53,20 +56,8 @@ namespace {
 
 namespace draw {
 
-bitmap const& glyph_cache::get(font const& f, char32_t const code_point) {
-  auto const key =
-      (static_cast<std::uint32_t>(f.id) << icubaby::code_point_bits) | static_cast<std::uint32_t>(code_point);
-  return cache_.access(key, [this, &f, code_point](std::uint32_t const /*key*/, std::size_t const index) {
-    // Called when a glyph was not found in the cache.
-    using difference_type = decltype(store_)::difference_type;
-    auto const begin = std::begin(store_) + static_cast<difference_type>(index * store_size_);
-    auto const end = begin + static_cast<difference_type>(store_size_);
-    assert(end <= std::end(store_));
-    return glyph_cache::render(f, code_point, std::span{begin, end});
-  });
-}
-
-bitmap glyph_cache::render(font const& f, char32_t const code_point, std::span<std::byte> bitmap_store) {
+bitmap glyph_source::render(font const& f, char32_t const code_point, std::span<std::byte> bitmap_store) {
+  static_assert(code_point_bits == icubaby::code_point_bits);
   /// Enable to inspect the unpacking and rotation of the font data.
   // ReSharper disable once CppTooWideScope
   constexpr tracer<false> trace;
@@ -76,43 +67,125 @@ bitmap glyph_cache::render(font const& f, char32_t const code_point, std::span<s
 
   auto const& bitmaps = glyph->bm;
   auto const width = f.width(*glyph);
+  if (f.layout == glyph_layout::row_major) {
+    // The glyph is already in bitmap layout so the result can refer to the font data. Bitmaps are only made available
+    // as 'bitmap const' so the data is never modified.
+    return bitmap{std::span{const_cast<std::byte*>(bitmaps.data()), bitmaps.size()}, width, height};
+  }
   bitmap bm{bitmap_store, width, height};
-  for (auto y = std::size_t{0U}; y < height; ++y) {
-    trace("|");
-
+  std::size_t const stride = bm.stride();
+  // Reads the byte holding the 8 pixels of 'row' in column x. Columns beyond the width of the glyph are blank so
+  // that the padding bits at the end of each bitmap row are clear.
+  auto const column = [&bitmaps, &f, width](unsigned const x, unsigned const row) {
+    if (x >= width) {
+      return std::uint8_t{0};
+    }
+    auto const src_index = (x * f.height) + row;
+    assert(src_index < bitmaps.size() && "The source byte is not within the bitmap");
+    return std::to_integer<std::uint8_t>(bitmaps[src_index]);
+  };
+  // The glyph is converted in blocks 8 pixels tall: a single source byte from each column.
+  for (auto row = 0U; row < f.height; ++row) {
+    auto* const dest = bitmap_store.data() + row * 8U * stride;
     auto x = 0U;
-
-    if (width >= 8U) {
-      // Assign whole bytes.
-      for (; x < (width & ~0b111U); x += 8U) {
-        auto pixels = std::byte{0U};
-        for (auto bit = 0U; bit < 8U; ++bit) {
-          auto const src_index = ((x + bit) * f.height) + (y / 8U);
-          assert(src_index < bitmaps.size() && "The source byte is not within the bitmap");
-          if ((bitmaps[src_index] & (std::byte{1U} << (y % 8U))) != std::byte{0U}) {
-            pixels |= std::byte{0x80U} >> bit;
-          }
-        }
-
-        auto const dest_index = y * bm.stride() + (x / 8U);
-        assert(dest_index < bitmap_store.size() && "The destination byte is not within the bitmap store");
-        bitmap_store[dest_index] = pixels;
-        for (auto ctr = 0U; ctr < 8U; ++ctr) {
-          trace("{}", get_pixel_for_trace(pixels, 7 - ctr));
-        }
+#if DRAW_BIT_TRANSPOSE_SSE2 || DRAW_BIT_TRANSPOSE_NEON
+    // Convert 16 columns at a time while there are at least two destination bytes left in each row.
+    for (; x + 8U < width; x += details::transpose16_columns) {
+      std::array<std::uint8_t, details::transpose16_columns> block{};
+      for (auto i = 0U; i < details::transpose16_columns; ++i) {
+        block[i] = column(x + i, row);
       }
+      details::transpose16(block, dest + x / 8U, stride);
     }
+#endif  // DRAW_BIT_TRANSPOSE_SSE2 || DRAW_BIT_TRANSPOSE_NEON
+    for (; x < width; x += 8U) {
+      auto block = std::uint64_t{0};
+      for (auto i = 0U; i < 8U; ++i) {
+        block |= std::uint64_t{column(x + i, row)} << (56U - 8U * i);
+      }
+      auto const rows = details::transpose8(block);
+      for (auto y = 0U; y < 8U; ++y) {
+        dest[y * stride + x / 8U] = static_cast<std::byte>(rows >> (8U * y));
+      }
+    }
+  }
 
-    for (; x < width; ++x) {
-      auto const src_index = (x * f.height) + (y / 8U);
-      assert(src_index < bitmaps.size() && "The source byte is not within the bitmap");
-      auto const pixel = bitmaps[src_index] & (std::byte{1U} << (y % 8U));
-      bm.set(point{.x = static_cast<coordinate>(x), .y = static_cast<coordinate>(y)}, pixel != std::byte{0});
-      trace("{}", pixel != std::byte{0U} ? 'X' : ' ');
+  for (auto y = std::size_t{0U}; y < height; ++y) {
+    trace("|");
+    for (auto x = 0U; x < width; ++x) {
+      trace("{}", get_pixel_for_trace(bitmap_store[y * stride + x / 8U], 7U - x % 8U));
     }
     trace("|{0}\n", y == f.baseline ? "<-" : "");
   }
   return bm;
 }
 
+namespace details {
+
+std::size_t glyph_slab::used(std::size_t const first) const noexcept {
+  auto result = std::size_t{0};
+  for (auto index = first; index < first + ways_; ++index) {
+    if (this->live(index)) {
+      result = std::max(result, std::size_t{slots_[index].offset} + slots_[index].size);
+    }
+  }
+  return result;
+}
+
+void glyph_slab::release(std::size_t const index) {
+  assert(this->live(index) && "Only a live glyph can be released");
+  auto& slot = slots_[index];
+  auto const first = index - index % ways_;
+  auto const end = this->used(first);
+  slot.glyph->live = false;
+  if (slot.size == 0U) {
+    return;
+  }
+  // Move the glyphs that follow this one down to close the gap.
+  auto const set_base = store_.subspan((first / ways_) * set_size_, set_size_);
+  auto const gap_end = std::size_t{slot.offset} + slot.size;
+  std::copy(set_base.begin() + static_cast<std::ptrdiff_t>(gap_end), set_base.begin() + static_cast<std::ptrdiff_t>(end),
+            set_base.begin() + static_cast<std::ptrdiff_t>(slot.offset));
+  for (auto other = first; other < first + ways_; ++other) {
+    auto& s = slots_[other];
+    if (this->live(other) && s.size > 0U && s.offset > slot.offset) {
+      s.offset -= slot.size;
+      auto& bm = s.glyph->bm;
+      bm = bitmap{set_base.subspan(s.offset, s.size), bm.width(), bm.height()};
+    }
+  }
+  slot.size = 0U;
+}
+
+auto glyph_slab::allocate(std::size_t const index, std::size_t const size) -> allocation {
+  assert(size <= set_size_ && "The glyph is too large for a cache set");
+  auto const first = index - index % ways_;
+  auto evicted = 0U;
+  if (this->live(index)) {
+    this->release(index);
+    ++evicted;
+  }
+  // Drop other glyphs from the set until there is room for the new one.
+  for (auto step = std::size_t{1}; step < ways_ && this->used(first) + size > set_size_; ++step) {
+    auto const other = first + (index - first + step) % ways_;
+    if (this->live(other) && slots_[other].size > 0U) {
+      this->release(other);
+      ++evicted;
+    }
+  }
+  auto& slot = slots_[index];
+  slot.offset = static_cast<std::uint32_t>(this->used(first));
+  slot.size = static_cast<std::uint32_t>(size);
+  assert(slot.offset + size <= set_size_);
+  return {.store = store_.subspan((first / ways_) * set_size_ + slot.offset, size), .evicted = evicted};
+}
+
+}  // end namespace details
+
+bitmap const& glyph_view::get(font const& f, char32_t const code_point) {
+  assert(f.layout == glyph_layout::row_major && "glyph_view requires a font with row-major glyphs");
+  bm_ = glyph_source::render(f, code_point, std::span<std::byte>{});
+  return bm_;
+}
+
 }  // end namespace draw
@@ -0,0 +1,218 @@
+//===- lib/gray_bitmap.cpp ------------------------------------------------===//
+//*                          _     _ _                          *
+//*   __ _ _ __ __ _ _   _  | |__ (_) |_ _ __ ___   __ _ _ __   *
+//*  / _` | '__/ _` | | | | | '_ \| | __| '_ ` _ \ / _` | '_ \  *
+//* | (_| | | | (_| | |_| | | |_) | | |_| | | | | | (_| | |_) | *
+//*  \__, |_|  \__,_|\__, | |_.__/|_|\__|_| |_| |_|\__,_| .__/  *
+//*  |___/           |___/                              |_|     *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+#include "draw/gray_bitmap.hpp"
+
+// Standard library
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string_view>
+
+// Local includes
+#include "draw/bitmap.hpp"
+#include "draw/font.hpp"
+#include "draw/glyph_cache.hpp"
+#include "draw/text.hpp"
+#include "draw/types.hpp"
+#include "span32.hpp"
+
+namespace {
+
+/// Returns the eight bits of a row starting at bit \p bit. The position may lie up to seven bits before the start of
+/// the row: bits that lie outside the row are zero.
+[[nodiscard]] constexpr std::byte fetch_bits(std::span<std::byte const> const row, int const bit) noexcept {
+  assert(bit > -8 && "bit position is too far before the row");
+  if (bit < 0) {
+    return static_cast<std::byte>(draw::details::fetch8(row, 0U) >> -bit);
+  }
+  return static_cast<std::byte>(draw::details::fetch8(row, static_cast<unsigned>(bit)));
+}
+
+/// Returns a mask selecting the pixels of byte \p index of a packed row that lie within the run [x0, x1].
+template <unsigned Bits>
+[[nodiscard]] constexpr std::byte edge_mask(unsigned const index, unsigned const x0, unsigned const x1) noexcept {
+  constexpr auto pixels_per_byte = draw::packed_format<Bits>::pixels_per_byte;
+  auto edge = std::byte{0xFF};
+  if (index == x0 / pixels_per_byte) {
+    edge &= std::byte{0xFF} >> (x0 % pixels_per_byte * Bits);
+  }
+  if (index == x1 / pixels_per_byte) {
+    edge &= std::byte{0xFF} << ((pixels_per_byte - 1U - x1 % pixels_per_byte) * Bits);
+  }
+  return edge;
+}
+
+/// Copies \p count pixels of a packed source row starting at \p src_x to a packed destination row starting at
+/// \p dest_x. Each destination byte is assembled from a 16-bit window over the source so that the source and
+/// destination needn't share the same alignment within a byte. If they do, the bytes between the two edges are copied
+/// directly.
+template <unsigned Bits>
+void copy_row(std::byte* const DRAW_NONNULL dest_row, unsigned const dest_x, std::span<std::byte const> const src_row,
+              unsigned const src_x, unsigned const count) noexcept {
+  assert(count > 0U);
+  constexpr auto pixels_per_byte = draw::packed_format<Bits>::pixels_per_byte;
+  auto const x1 = dest_x + count - 1U;
+  auto const first = dest_x / pixels_per_byte;
+  auto const last = x1 / pixels_per_byte;
+  // The distance in bits from a destination bit to the corresponding source bit.
+  auto const shift = static_cast<int>(src_x * Bits) - static_cast<int>(dest_x * Bits);
+
+  auto index = first;
+  auto const transfer = [&](unsigned const i) {
+    auto const edge = edge_mask<Bits>(i, dest_x, x1);
+    auto const v = fetch_bits(src_row, static_cast<int>(i * 8U) + shift);
+    dest_row[i] = (dest_row[i] & ~edge) | (v & edge);
+  };
+  transfer(index++);
+  if (index >= last) {
+    if (index == last) {
+      transfer(index);
+    }
+    return;
+  }
+  if (shift % 8 == 0) {
+    // The source and destination are aligned: whole bytes between the edges are copied as they stand.
+    auto const len = last - index;
+    std::memcpy(dest_row + index, src_row.data() + static_cast<int>(index) + shift / 8, len);
+    index += len;
+  } else {
+    for (; index < last; ++index) {
+      dest_row[index] = fetch_bits(src_row, static_cast<int>(index * 8U) + shift);
+    }
+  }
+  transfer(index);
+}
+
+/// Maps the top pixels_per_byte bits of a 1bpp byte to a mask covering the corresponding packed pixels. With 2bpp
+/// each crumb of the result comes from one of four source bits; with 4bpp each nibble comes from one of two.
+template <unsigned Bits> constexpr auto widen_table = [] {
+  using format = draw::packed_format<Bits>;
+  std::array<std::byte, 1U << format::pixels_per_byte> result{};
+  for (auto index = 0U; index < result.size(); ++index) {
+    result[index] = format::expand_pattern(static_cast<std::byte>(index << (8U - format::pixels_per_byte)))[0];
+  }
+  return result;
+}();
+
+/// Paints the pixels [dest_x, dest_x + count) of a packed destination row with \p ink where the corresponding pixel of
+/// a 1bpp source row is set, and with \p paper (if present) where it is clear. Destination bytes are visited in turn
+/// and their mask looked up from the source bits that they cover.
+template <unsigned Bits>
+void expand_row(std::byte* const DRAW_NONNULL dest_row, unsigned const dest_x, std::span<std::byte const> const src_row,
+                unsigned const src_x, unsigned const count, std::byte const ink,
+                std::optional<std::byte> const& paper) noexcept {
+  assert(count > 0U);
+  constexpr auto pixels_per_byte = draw::packed_format<Bits>::pixels_per_byte;
+  auto const x1 = dest_x + count - 1U;
+  auto const last = x1 / pixels_per_byte;
+  for (auto index = dest_x / pixels_per_byte; index <= last; ++index) {
+    auto const edge = edge_mask<Bits>(index, dest_x, x1);
+    // The source x-ordinate corresponding to the first pixel of this destination byte.
+    auto const sx = static_cast<int>(src_x) + static_cast<int>(index * pixels_per_byte) - static_cast<int>(dest_x);
+    auto const bits = std::to_integer<unsigned>(fetch_bits(src_row, sx)) >> (8U - pixels_per_byte);
+    auto const mask = widen_table<Bits>[bits] & edge;
+    auto& d = dest_row[index];
+    if (paper) {
+      d = (d & ~edge) | (mask & ink) | (~mask & edge & *paper);
+    } else if (mask != std::byte{0}) {
+      d = (d & ~mask) | (mask & ink);
+    }
+  }
+}
+
+}  // end anonymous namespace
+
+namespace draw {
+
+template <unsigned Bits>
+  requires(Bits == 2U || Bits == 4U)
+void gray_bitmap<Bits>::copy(gray_bitmap const& source, point const dest_pos) {
+  auto const area = this->clip_blit(source.bounds(), source.width(), source.height(), dest_pos);
+  if (!area) {
+    return;
+  }
+  for (auto y = 0U; y < area->height; ++y) {
+    auto const src_row = source.store().subspan((area->src_y + y) * source.stride(), source.stride());
+    copy_row<Bits>(&this->store_[(area->dest_y + y) * this->stride_], area->dest_x, src_row, area->src_x,
+                   area->width);
+  }
+  this->mark_dirty(*area);
+}
+
+template <unsigned Bits>
+  requires(Bits == 2U || Bits == 4U)
+void gray_bitmap<Bits>::expand(bitmap const& source, rect const& src_rect, point const dest_pos, value_type const fg,
+                               std::optional<value_type> const bg) {
+  using format = packed_format<Bits>;
+  auto const area = this->clip_blit(src_rect, source.width(), source.height(), dest_pos);
+  if (!area) {
+    return;
+  }
+  auto const ink = format::replicate(fg);
+  auto const paper = bg ? std::optional{format::replicate(*bg)} : std::nullopt;
+  for (auto y = 0U; y < area->height; ++y) {
+    auto const src_row = source.store().subspan((area->src_y + y) * source.stride(), source.stride());
+    expand_row<Bits>(&this->store_[(area->dest_y + y) * this->stride_], area->dest_x, src_row, area->src_x,
+                     area->width, ink, paper);
+  }
+  this->mark_dirty(*area);
+}
+
+template <unsigned Bits>
+  requires(Bits == 2U || Bits == 4U)
+void gray_bitmap<Bits>::draw_char(glyph_source& gc, font const& f, char32_t const code_point, point const pos,
+                                  value_type const ink) {
+  if (pos.x > this->width() || pos.y > this->height()) {
+    return;
+  }
+  bitmap const& glyph = gc.get(f, code_point);
+  this->expand(glyph, glyph.bounds(), pos, ink);
+}
+
+template <unsigned Bits>
+  requires(Bits == 2U || Bits == 4U)
+point gray_bitmap<Bits>::draw_string(glyph_source& gc, font const& f, std::u8string_view s, point pos,
+                                     value_type const ink) {
+  coordinate const new_x = scan_string(f, s, [this, &gc, &f, &pos, ink](char32_t code_point, coordinate x) {
+    this->draw_char(gc, f, code_point, {.x = static_cast<coordinate>(pos.x + x), .y = pos.y}, ink);
+  });
+  return {.x = static_cast<coordinate>(pos.x + new_x), .y = pos.y};
+}
+
+template class gray_bitmap<2>;
+template class gray_bitmap<4>;
+
+}  // end namespace draw
@@ -0,0 +1,129 @@
+//===- lib/indexed8_bitmap.cpp --------------------------------------------===//
+//*  _           _                   _  ___    _     _ _                          *
+//* (_)_ __   __| | _____  _____  __| |( _ )  | |__ (_) |_ _ __ ___   __ _ _ __   *
+//* | | '_ \ / _` |/ _ \ \/ / _ \/ _` |/ _ \  | '_ \| | __| '_ ` _ \ / _` | '_ \  *
+//* | | | | | (_| |  __/>  <  __/ (_| | (_) | | |_) | | |_| | | | | | (_| | |_) | *
+//* |_|_| |_|\__,_|\___/_/\_\___|\__,_|\___/  |_.__/|_|\__|_| |_| |_|\__,_| .__/  *
+//*                                                                       |_|     *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+#include "draw/indexed8_bitmap.hpp"
+
+// Standard library
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string_view>
+
+// Local includes
+#include "draw/bitmap.hpp"
+#include "draw/font.hpp"
+#include "draw/glyph_cache.hpp"
+#include "draw/text.hpp"
+#include "draw/types.hpp"
+#include "span32.hpp"
+
+namespace {
+
+/// Writes \p fg to each of a run of \p count pixels where the corresponding pixel of a 1bpp source row is set and
+/// \p bg (if present) where it is clear. Blocks of eight source pixels that are all set or all clear are written
+/// with memset (or skipped) rather than a pixel at a time.
+void expand_row(std::uint8_t* DRAW_NONNULL dest, std::size_t count, std::span<std::byte const> const src_row,
+                unsigned src_x, std::uint8_t const fg, std::optional<std::uint8_t> const& bg) noexcept {
+  while (count > 0U) {
+    auto const n = std::min(count, std::size_t{8});
+    // Clear any bits beyond the end of the run.
+    auto const bits = static_cast<std::uint8_t>(draw::details::fetch8(src_row, src_x) & ~(0xFFU >> n));
+    auto const full = static_cast<std::uint8_t>(~(0xFFU >> n));
+    if (bits == full) {
+      std::memset(dest, fg, n);
+    } else if (bits == 0U && bg) {
+      std::memset(dest, *bg, n);
+    } else if (bits != 0U || bg) {
+      for (auto x = 0U; x < n; ++x) {
+        if ((bits & (0x80U >> x)) != 0U) {
+          dest[x] = fg;
+        } else if (bg) {
+          dest[x] = *bg;
+        }
+      }
+    }
+    dest += n;
+    src_x += static_cast<unsigned>(n);
+    count -= n;
+  }
+}
+
+}  // end anonymous namespace
+
+namespace draw {
+
+void indexed8_bitmap::copy(indexed8_bitmap const& source, point const dest_pos) {
+  auto const area = this->clip_blit(source.bounds(), source.width(), source.height(), dest_pos);
+  if (!area) {
+    return;
+  }
+  for (auto y = 0U; y < area->height; ++y) {
+    std::memcpy(&store_[(area->dest_y + y) * stride_ + area->dest_x],
+                &source.store_[(area->src_y + y) * source.stride_ + area->src_x], area->width);
+  }
+  this->mark_dirty(*area);
+}
+
+void indexed8_bitmap::expand(bitmap const& source, rect const& src_rect, point const dest_pos, value_type const fg,
+                             std::optional<value_type> const bg) {
+  auto const area = this->clip_blit(src_rect, source.width(), source.height(), dest_pos);
+  if (!area) {
+    return;
+  }
+  for (auto y = 0U; y < area->height; ++y) {
+    auto const src_row = source.store().subspan((area->src_y + y) * source.stride(), source.stride());
+    expand_row(&store_[(area->dest_y + y) * stride_ + area->dest_x], area->width, src_row, area->src_x, fg, bg);
+  }
+  this->mark_dirty(*area);
+}
+
+void indexed8_bitmap::draw_char(glyph_source& gc, font const& f, char32_t const code_point, point const pos,
+                                value_type const index) {
+  if (pos.x > this->width() || pos.y > this->height()) {
+    return;
+  }
+  bitmap const& glyph = gc.get(f, code_point);
+  this->expand(glyph, glyph.bounds(), pos, index);
+}
+
+point indexed8_bitmap::draw_string(glyph_source& gc, font const& f, std::u8string_view s, point pos,
+                                   value_type const index) {
+  coordinate const new_x = scan_string(f, s, [this, &gc, &f, &pos, index](char32_t code_point, coordinate x) {
+    this->draw_char(gc, f, code_point, {.x = static_cast<coordinate>(pos.x + x), .y = pos.y}, index);
+  });
+  return {.x = static_cast<coordinate>(pos.x + new_x), .y = pos.y};
+}
+
+}  // end namespace draw
@@ -0,0 +1,62 @@
+//===- lib/label_cache.cpp ------------------------------------------------===//
+//*  _       _          _                  _           *
+//* | | __ _| |__   ___| |   ___ __ _  ___| |__   ___  *
+//* | |/ _` | '_ \ / _ \ |  / __/ _` |/ __| '_ \ / _ \ *
+//* | | (_| | |_) |  __/ | | (_| (_| | (__| | | |  __/ *
+//* |_|\__,_|_.__/ \___|_|  \___\__,_|\___|_| |_|\___| *
+//*                                                    *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+#include "draw/label_cache.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// Local includes
+#include "draw/bitmap.hpp"
+#include "draw/text.hpp"
+#include "draw/types.hpp"
+
+namespace draw {
+namespace details {
+
+std::uint16_t label_width(font const& f, std::u8string_view const s) {
+  return static_cast<std::uint16_t>(std::max(string_width(f, s), coordinate{0}));
+}
+
+bitmap render_label(glyph_source& gc, font const& f, std::u8string_view const s, std::uint16_t const width,
+                    std::span<std::byte> const store) {
+  bitmap bm{store, width, static_cast<std::uint16_t>(f.height * 8U)};
+  bm.clear();
+  if (width > 0U) {
+    bm.draw_string(gc, f, s, point{.x = 0, .y = 0});
+  }
+  return bm;
+}
+
+}  // end namespace details
+}  // end namespace draw
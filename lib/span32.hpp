@@ -0,0 +1,1058 @@
+//===- lib/span32.hpp -------------------------------------*- mode: C++ -*-===//
+//*                        _________   *
+//*  ___ _ __   __ _ _ __ |___ /___ \  *
+//* / __| '_ \ / _` | '_ \  |_ \ __) | *
+//* \__ \ |_) | (_| | | | |___) / __/  *
+//* |___/ .__/ \__,_|_| |_|____/_____| *
+//*     |_|                            *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+/// \file span32.hpp
+/// \brief Span kernels for rgba_premult pixel rows.
+///
+/// The kernels are written in terms of a small vector layer: pixels4 holds four packed rgba_premult pixels and
+/// channels8 holds two pixels widened to one 16-bit lane per channel. The layer has SSE2 and NEON implementations
+/// along with a portable fallback that produces identical results, so each kernel is written just once.
+///
+/// Which pixels in a block are affected is described by a per-lane blend mask so that the inner loops contain no
+/// per-pixel branches.
+
+#ifndef DRAW_SPAN32_HPP
+#define DRAW_SPAN32_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#if defined(__ARM_NEON) && __ARM_NEON
+#include <arm_neon.h>
+#define DRAW_SPAN32_NEON (1)
+#define DRAW_SPAN32_SSE2 (0)
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define DRAW_SPAN32_NEON (0)
+#define DRAW_SPAN32_SSE2 (1)
+#else
+#define DRAW_SPAN32_NEON (0)
+#define DRAW_SPAN32_SSE2 (0)
+#endif
+
+#include "draw/bitmap32.hpp"
+#include "draw/types.hpp"
+
+namespace draw::details {
+
+/// A blend mask for a block of eight consecutive pixels. Each lane is either all ones (the pixel is painted) or all
+/// zeros (the pixel is left untouched).
+using lane_mask8 = std::array<std::uint32_t, 8>;
+
+/// Expands an 8-bit mask into a per-lane blend mask. As in the 1bpp bitmap, the most significant bit corresponds to
+/// the left-most pixel (lane 0).
+[[nodiscard]] constexpr lane_mask8 expand_mask(std::uint8_t const bits) noexcept {
+  lane_mask8 result{};
+  for (auto lane = 0U; lane < 8U; ++lane) {
+    result[lane] = std::uint32_t{0} - ((static_cast<std::uint32_t>(bits) >> (7U - lane)) & 1U);
+  }
+  return result;
+}
+
+// The vector layer
+// ~~~~~~~~~~~~~~~~
+// Every channels8 lane holds a value no greater than 0xFF on entry to each operation except add8() whose result
+// saturates at 0xFFFF. narrow() saturates to 0xFF. The exceptions are load16(), store16(), and mulhi8() which are
+// used by the linear-light kernel: there each lane holds a 16-bit fraction. The weights passed to lerp8() are no
+// greater than 0xFF.
+
+#if DRAW_SPAN32_SSE2
+using pixels4 = __m128i;
+using channels8 = __m128i;
+
+[[nodiscard]] inline pixels4 load4(rgba_premult const* const DRAW_NONNULL p) noexcept {
+  return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));  // NOLINT(*-reinterpret-cast)
+}
+inline void store4(rgba_premult* const DRAW_NONNULL p, pixels4 const v) noexcept {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);  // NOLINT(*-reinterpret-cast)
+}
+[[nodiscard]] inline pixels4 splat4(rgba_premult const& c) noexcept {
+  return _mm_set1_epi32(std::bit_cast<int>(c));
+}
+[[nodiscard]] inline pixels4 load_mask4(std::uint32_t const* const DRAW_NONNULL m) noexcept {
+  return _mm_loadu_si128(reinterpret_cast<__m128i const*>(m));  // NOLINT(*-reinterpret-cast)
+}
+/// Broadcasts the four low bits of \p bits to a lane mask. Bit 3 selects lane 0.
+[[nodiscard]] inline pixels4 mask4_from_bits(unsigned const bits) noexcept {
+  __m128i const weights = _mm_set_epi32(1, 2, 4, 8);
+  return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(static_cast<int>(bits)), weights), weights);
+}
+/// Returns \p a where \p mask is set and \p b where it is clear.
+[[nodiscard]] inline pixels4 select4(pixels4 const mask, pixels4 const a, pixels4 const b) noexcept {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+/// Returns a lane mask which is set for each pixel of \p a that is identical to the corresponding pixel of \p b.
+[[nodiscard]] inline pixels4 equal4(pixels4 const a, pixels4 const b) noexcept {
+  return _mm_cmpeq_epi32(a, b);
+}
+[[nodiscard]] inline channels8 widen_lo(pixels4 const v) noexcept {
+  return _mm_unpacklo_epi8(v, _mm_setzero_si128());
+}
+[[nodiscard]] inline channels8 widen_hi(pixels4 const v) noexcept {
+  return _mm_unpackhi_epi8(v, _mm_setzero_si128());
+}
+[[nodiscard]] inline pixels4 narrow(channels8 const lo, channels8 const hi) noexcept {
+  return _mm_packus_epi16(lo, hi);
+}
+[[nodiscard]] inline channels8 splat8(std::uint16_t const v) noexcept {
+  return _mm_set1_epi16(static_cast<short>(v));
+}
+[[nodiscard]] inline channels8 add8(channels8 const a, channels8 const b) noexcept {
+  return _mm_adds_epu16(a, b);
+}
+[[nodiscard]] inline channels8 sub8(channels8 const a, channels8 const b) noexcept {
+  return _mm_subs_epu16(a, b);
+}
+// SSE2 has no unsigned 16-bit min/max but the lanes never exceed 0x7FFF so the signed versions are equivalent.
+[[nodiscard]] inline channels8 min8(channels8 const a, channels8 const b) noexcept {
+  return _mm_min_epi16(a, b);
+}
+[[nodiscard]] inline channels8 max8(channels8 const a, channels8 const b) noexcept {
+  return _mm_max_epi16(a, b);
+}
+/// Returns a*b/255 using the same approximation as rgba_premult so that results are bit-identical to the scalar code.
+[[nodiscard]] inline channels8 mul255(channels8 const a, channels8 const b) noexcept {
+  __m128i const p = _mm_mullo_epi16(a, b);
+  return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(p, _mm_set1_epi16(0x80)), _mm_srli_epi16(p, 8)), 8);
+}
+/// Copies the alpha channel of each pixel to all four of its lanes.
+[[nodiscard]] inline channels8 alpha8(channels8 const v) noexcept {
+  return _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+[[nodiscard]] inline channels8 load16(std::uint16_t const* const DRAW_NONNULL p) noexcept {
+  return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));  // NOLINT(*-reinterpret-cast)
+}
+inline void store16(std::uint16_t* const DRAW_NONNULL p, channels8 const v) noexcept {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);  // NOLINT(*-reinterpret-cast)
+}
+/// Returns the high 16 bits of the 32-bit product of each pair of lanes.
+[[nodiscard]] inline channels8 mulhi8(channels8 const a, channels8 const b) noexcept {
+  return _mm_mulhi_epu16(a, b);
+}
+/// Interpolates between \p a and \p b: each lane of \p f is the weight of \p b in 256ths (0 to 255).
+[[nodiscard]] inline channels8 lerp8(channels8 const a, channels8 const b, channels8 const f) noexcept {
+  __m128i const sum = _mm_add_epi16(_mm_mullo_epi16(a, _mm_sub_epi16(_mm_set1_epi16(0x100), f)), _mm_mullo_epi16(b, f));
+  return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(0x80)), 8);
+}
+/// Loads four 8-bit coverage values and copies each to all four channels of the corresponding pixel.
+[[nodiscard]] inline pixels4 load_coverage4(std::uint8_t const* const DRAW_NONNULL p) noexcept {
+  int c = 0;
+  std::memcpy(&c, p, sizeof(c));
+  __m128i const v = _mm_cvtsi32_si128(c);
+  __m128i const v2 = _mm_unpacklo_epi8(v, v);
+  return _mm_unpacklo_epi16(v2, v2);
+}
+
+#elif DRAW_SPAN32_NEON
+using pixels4 = uint8x16_t;
+using channels8 = uint16x8_t;
+
+[[nodiscard]] inline pixels4 load4(rgba_premult const* const DRAW_NONNULL p) noexcept {
+  return vld1q_u8(reinterpret_cast<std::uint8_t const*>(p));  // NOLINT(*-reinterpret-cast)
+}
+inline void store4(rgba_premult* const DRAW_NONNULL p, pixels4 const v) noexcept {
+  vst1q_u8(reinterpret_cast<std::uint8_t*>(p), v);  // NOLINT(*-reinterpret-cast)
+}
+[[nodiscard]] inline pixels4 splat4(rgba_premult const& c) noexcept {
+  return vreinterpretq_u8_u32(vdupq_n_u32(std::bit_cast<std::uint32_t>(c)));
+}
+[[nodiscard]] inline pixels4 load_mask4(std::uint32_t const* const DRAW_NONNULL m) noexcept {
+  return vreinterpretq_u8_u32(vld1q_u32(m));
+}
+/// Broadcasts the four low bits of \p bits to a lane mask. Bit 3 selects lane 0.
+[[nodiscard]] inline pixels4 mask4_from_bits(unsigned const bits) noexcept {
+  static constexpr std::array<std::uint32_t, 4> weights{8, 4, 2, 1};
+  return vreinterpretq_u8_u32(vtstq_u32(vdupq_n_u32(bits), vld1q_u32(weights.data())));
+}
+/// Returns \p a where \p mask is set and \p b where it is clear.
+[[nodiscard]] inline pixels4 select4(pixels4 const mask, pixels4 const a, pixels4 const b) noexcept {
+  return vbslq_u8(mask, a, b);
+}
+/// Returns a lane mask which is set for each pixel of \p a that is identical to the corresponding pixel of \p b.
+[[nodiscard]] inline pixels4 equal4(pixels4 const a, pixels4 const b) noexcept {
+  return vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(a), vreinterpretq_u32_u8(b)));
+}
+[[nodiscard]] inline channels8 widen_lo(pixels4 const v) noexcept {
+  return vmovl_u8(vget_low_u8(v));
+}
+[[nodiscard]] inline channels8 widen_hi(pixels4 const v) noexcept {
+  return vmovl_u8(vget_high_u8(v));
+}
+[[nodiscard]] inline pixels4 narrow(channels8 const lo, channels8 const hi) noexcept {
+  return vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi));
+}
+[[nodiscard]] inline channels8 splat8(std::uint16_t const v) noexcept {
+  return vdupq_n_u16(v);
+}
+[[nodiscard]] inline channels8 add8(channels8 const a, channels8 const b) noexcept {
+  return vqaddq_u16(a, b);
+}
+[[nodiscard]] inline channels8 sub8(channels8 const a, channels8 const b) noexcept {
+  return vqsubq_u16(a, b);
+}
+[[nodiscard]] inline channels8 min8(channels8 const a, channels8 const b) noexcept {
+  return vminq_u16(a, b);
+}
+[[nodiscard]] inline channels8 max8(channels8 const a, channels8 const b) noexcept {
+  return vmaxq_u16(a, b);
+}
+/// Returns a*b/255 using the same approximation as rgba_premult so that results are bit-identical to the scalar code.
+[[nodiscard]] inline channels8 mul255(channels8 const a, channels8 const b) noexcept {
+  uint16x8_t const p = vmulq_u16(a, b);
+  return vshrq_n_u16(vaddq_u16(vaddq_u16(p, vdupq_n_u16(0x80)), vshrq_n_u16(p, 8)), 8);
+}
+/// Copies the alpha channel of each pixel to all four of its lanes.
+[[nodiscard]] inline channels8 alpha8(channels8 const v) noexcept {
+  return vcombine_u16(vdup_lane_u16(vget_low_u16(v), 3), vdup_lane_u16(vget_high_u16(v), 3));
+}
+[[nodiscard]] inline channels8 load16(std::uint16_t const* const DRAW_NONNULL p) noexcept {
+  return vld1q_u16(p);
+}
+inline void store16(std::uint16_t* const DRAW_NONNULL p, channels8 const v) noexcept {
+  vst1q_u16(p, v);
+}
+/// Returns the high 16 bits of the 32-bit product of each pair of lanes.
+[[nodiscard]] inline channels8 mulhi8(channels8 const a, channels8 const b) noexcept {
+  uint32x4_t const lo = vmull_u16(vget_low_u16(a), vget_low_u16(b));
+  uint32x4_t const hi = vmull_u16(vget_high_u16(a), vget_high_u16(b));
+  return vcombine_u16(vshrn_n_u32(lo, 16), vshrn_n_u32(hi, 16));
+}
+/// Interpolates between \p a and \p b: each lane of \p f is the weight of \p b in 256ths (0 to 255).
+[[nodiscard]] inline channels8 lerp8(channels8 const a, channels8 const b, channels8 const f) noexcept {
+  uint16x8_t const sum = vmlaq_u16(vmulq_u16(a, vsubq_u16(vdupq_n_u16(0x100), f)), b, f);
+  return vshrq_n_u16(vaddq_u16(sum, vdupq_n_u16(0x80)), 8);
+}
+/// Loads four 8-bit coverage values and copies each to all four channels of the corresponding pixel.
+[[nodiscard]] inline pixels4 load_coverage4(std::uint8_t const* const DRAW_NONNULL p) noexcept {
+  std::uint32_t c = 0;
+  std::memcpy(&c, p, sizeof(c));
+  uint8x8_t const v = vreinterpret_u8_u32(vdup_n_u32(c));
+  uint8x8_t const v2 = vzip_u8(v, v).val[0];
+  uint8x8x2_t const v4 = vzip_u8(v2, v2);
+  return vcombine_u8(v4.val[0], v4.val[1]);
+}
+
+#else
+using pixels4 = std::array<std::uint8_t, 16>;
+using channels8 = std::array<std::uint16_t, 8>;
+
+[[nodiscard]] inline pixels4 load4(rgba_premult const* const DRAW_NONNULL p) noexcept {
+  pixels4 result;
+  std::memcpy(result.data(), p, result.size());
+  return result;
+}
+inline void store4(rgba_premult* const DRAW_NONNULL p, pixels4 const& v) noexcept {
+  std::memcpy(p, v.data(), v.size());
+}
+[[nodiscard]] inline pixels4 splat4(rgba_premult const& c) noexcept {
+  pixels4 result;
+  for (auto ctr = 0U; ctr < 4U; ++ctr) {
+    std::memcpy(&result[ctr * 4U], &c, sizeof(c));
+  }
+  return result;
+}
+[[nodiscard]] inline pixels4 load_mask4(std::uint32_t const* const DRAW_NONNULL m) noexcept {
+  pixels4 result;
+  std::memcpy(result.data(), m, result.size());
+  return result;
+}
+/// Broadcasts the four low bits of \p bits to a lane mask. Bit 3 selects lane 0.
+[[nodiscard]] inline pixels4 mask4_from_bits(unsigned const bits) noexcept {
+  pixels4 result;
+  for (auto lane = 0U; lane < 4U; ++lane) {
+    auto const m = static_cast<std::uint8_t>(((bits >> (3U - lane)) & 1U) * 0xFFU);
+    std::fill_n(result.begin() + lane * 4U, 4U, m);
+  }
+  return result;
+}
+/// Returns \p a where \p mask is set and \p b where it is clear.
+[[nodiscard]] inline pixels4 select4(pixels4 const& mask, pixels4 const& a, pixels4 const& b) noexcept {
+  pixels4 result;
+  for (auto lane = 0U; lane < result.size(); ++lane) {
+    result[lane] = static_cast<std::uint8_t>((mask[lane] & a[lane]) | (~mask[lane] & b[lane]));
+  }
+  return result;
+}
+/// Returns a lane mask which is set for each pixel of \p a that is identical to the corresponding pixel of \p b.
+[[nodiscard]] inline pixels4 equal4(pixels4 const& a, pixels4 const& b) noexcept {
+  pixels4 result;
+  for (auto lane = 0U; lane < result.size(); lane += 4U) {
+    auto const m = std::equal(&a[lane], &a[lane + 4U], &b[lane]) ? std::uint8_t{0xFF} : std::uint8_t{0x00};
+    std::fill_n(result.begin() + lane, 4U, m);
+  }
+  return result;
+}
+[[nodiscard]] inline channels8 widen_lo(pixels4 const& v) noexcept {
+  channels8 result;
+  std::copy_n(v.begin(), result.size(), result.begin());
+  return result;
+}
+[[nodiscard]] inline channels8 widen_hi(pixels4 const& v) noexcept {
+  channels8 result;
+  std::copy_n(v.begin() + result.size(), result.size(), result.begin());
+  return result;
+}
+[[nodiscard]] inline pixels4 narrow(channels8 const& lo, channels8 const& hi) noexcept {
+  pixels4 result;
+  for (auto lane = 0U; lane < lo.size(); ++lane) {
+    result[lane] = static_cast<std::uint8_t>(std::min(lo[lane], std::uint16_t{0xFF}));
+    result[lane + lo.size()] = static_cast<std::uint8_t>(std::min(hi[lane], std::uint16_t{0xFF}));
+  }
+  return result;
+}
+[[nodiscard]] inline channels8 splat8(std::uint16_t const v) noexcept {
+  channels8 result;
+  result.fill(v);
+  return result;
+}
+template <typename Function>
+[[nodiscard]] inline channels8 zip8(channels8 const& a, channels8 const& b, Function const f) noexcept {
+  channels8 result;
+  for (auto lane = 0U; lane < result.size(); ++lane) {
+    result[lane] = static_cast<std::uint16_t>(f(static_cast<unsigned>(a[lane]), static_cast<unsigned>(b[lane])));
+  }
+  return result;
+}
+[[nodiscard]] inline channels8 add8(channels8 const& a, channels8 const& b) noexcept {
+  return zip8(a, b, [](unsigned x, unsigned y) { return std::min(x + y, 0xFFFFU); });
+}
+[[nodiscard]] inline channels8 sub8(channels8 const& a, channels8 const& b) noexcept {
+  return zip8(a, b, [](unsigned x, unsigned y) { return x > y ? x - y : 0U; });
+}
+[[nodiscard]] inline channels8 min8(channels8 const& a, channels8 const& b) noexcept {
+  return zip8(a, b, [](unsigned x, unsigned y) { return std::min(x, y); });
+}
+[[nodiscard]] inline channels8 max8(channels8 const& a, channels8 const& b) noexcept {
+  return zip8(a, b, [](unsigned x, unsigned y) { return std::max(x, y); });
+}
+/// Returns a*b/255 using the same approximation as rgba_premult.
+[[nodiscard]] inline channels8 mul255(channels8 const& a, channels8 const& b) noexcept {
+  return zip8(a, b, [](unsigned x, unsigned y) {
+    auto const p = (x * y) & 0xFFFFU;
+    return ((p + 0x80U + (p >> 8U)) & 0xFFFFU) >> 8U;
+  });
+}
+/// Copies the alpha channel of each pixel to all four of its lanes.
+[[nodiscard]] inline channels8 alpha8(channels8 const& v) noexcept {
+  channels8 result;
+  for (auto lane = 0U; lane < result.size(); ++lane) {
+    result[lane] = v[(lane & ~3U) + 3U];
+  }
+  return result;
+}
+[[nodiscard]] inline channels8 load16(std::uint16_t const* const DRAW_NONNULL p) noexcept {
+  channels8 result;
+  std::copy_n(p, result.size(), result.begin());
+  return result;
+}
+inline void store16(std::uint16_t* const DRAW_NONNULL p, channels8 const& v) noexcept {
+  std::ranges::copy(v, p);
+}
+/// Returns the high 16 bits of the 32-bit product of each pair of lanes.
+[[nodiscard]] inline channels8 mulhi8(channels8 const& a, channels8 const& b) noexcept {
+  return zip8(a, b, [](unsigned x, unsigned y) { return (x * y) >> 16U; });
+}
+/// Interpolates between \p a and \p b: each lane of \p f is the weight of \p b in 256ths (0 to 255).
+[[nodiscard]] inline channels8 lerp8(channels8 const& a, channels8 const& b, channels8 const& f) noexcept {
+  channels8 result;
+  for (auto lane = 0U; lane < result.size(); ++lane) {
+    result[lane] = static_cast<std::uint16_t>((a[lane] * (0x100U - f[lane]) + b[lane] * f[lane] + 0x80U) >> 8U);
+  }
+  return result;
+}
+/// Loads four 8-bit coverage values and copies each to all four channels of the corresponding pixel.
+[[nodiscard]] inline pixels4 load_coverage4(std::uint8_t const* const DRAW_NONNULL p) noexcept {
+  pixels4 result;
+  for (auto lane = 0U; lane < result.size(); ++lane) {
+    result[lane] = p[lane / 4U];
+  }
+  return result;
+}
+#endif  // DRAW_SPAN32_SSE2
+
+/// Composites \p src over \p dest.
+[[nodiscard]] inline channels8 over8(channels8 const src, channels8 const dest) noexcept {
+  return add8(src, mul255(dest, sub8(splat8(0xFF), alpha8(src))));
+}
+
+/// Copies a row of source pixels to the destination except for those that are identical to \p key which leave the
+/// destination unchanged. Each block of four pixels is compared with the key and merged with the destination using
+/// a lane mask so that there are no per-pixel branches.
+///
+/// \param dest  The first pixel of the destination row.
+/// \param src  The first pixel of the source row.
+/// \param count  The number of pixels in the row.
+/// \param key  The source value that marks transparent pixels.
+inline void keyed_row(rgba_premult* DRAW_NONNULL dest, rgba_premult const* DRAW_NONNULL src, std::size_t count,
+                      rgba_premult const& key) noexcept {
+  pixels4 const k = splat4(key);
+  for (; count >= 4U; count -= 4U) {
+    pixels4 const s = load4(src);
+    store4(dest, select4(equal4(s, k), load4(dest), s));
+    src += 4;
+    dest += 4;
+  }
+  if (count > 0U) {
+    // The final partial block goes via temporaries so that the kernel never touches pixels beyond the row.
+    std::array<rgba_premult, 4> s{};
+    std::array<rgba_premult, 4> d{};
+    std::copy_n(src, count, s.begin());
+    std::copy_n(dest, count, d.begin());
+    keyed_row(d.data(), s.data(), d.size(), key);
+    std::copy_n(d.begin(), count, dest);
+  }
+}
+
+// The word layer
+// ~~~~~~~~~~~~~~
+// words4 holds four pixels with one 32-bit lane per pixel: red in the least significant byte followed by green, blue,
+// and alpha. It is used to repack pixels into other formats. mul_words() requires that each product fits in 16 bits.
+// The store functions write the low 8, 16, or 24 bits of each lane to consecutive locations in memory; store_bytes8()
+// requires that each lane is no greater than 0xFF.
+
+#if DRAW_SPAN32_SSE2
+using words4 = __m128i;
+
+[[nodiscard]] inline words4 load_words(rgba_premult const* const DRAW_NONNULL p) noexcept {
+  return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));  // NOLINT(*-reinterpret-cast)
+}
+[[nodiscard]] inline words4 load_words(std::uint32_t const* const DRAW_NONNULL p) noexcept {
+  return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));  // NOLINT(*-reinterpret-cast)
+}
+[[nodiscard]] inline words4 splat_words(std::uint32_t const v) noexcept {
+  return _mm_set1_epi32(static_cast<int>(v));
+}
+[[nodiscard]] inline words4 and_words(words4 const a, words4 const b) noexcept {
+  return _mm_and_si128(a, b);
+}
+[[nodiscard]] inline words4 or_words(words4 const a, words4 const b) noexcept {
+  return _mm_or_si128(a, b);
+}
+[[nodiscard]] inline words4 add_words(words4 const a, words4 const b) noexcept {
+  return _mm_add_epi32(a, b);
+}
+// The lanes are below 0x10000 so a 16-bit multiply produces the complete product.
+[[nodiscard]] inline words4 mul_words(words4 const a, std::uint16_t const k) noexcept {
+  return _mm_mullo_epi16(a, _mm_set1_epi32(k));
+}
+template <unsigned Shift> [[nodiscard]] inline words4 shl_words(words4 const v) noexcept {
+  return _mm_slli_epi32(v, Shift);
+}
+template <unsigned Shift> [[nodiscard]] inline words4 shr_words(words4 const v) noexcept {
+  return _mm_srli_epi32(v, Shift);
+}
+[[nodiscard]] inline words4 xor_words(words4 const a, words4 const b) noexcept {
+  return _mm_xor_si128(a, b);
+}
+/// Returns a 4-bit mask with a bit set for each lane of \p a that is less than the corresponding lane of \p b. Lane 0
+/// is the most significant bit. The lanes must not exceed 0x7FFFFFFF.
+[[nodiscard]] inline unsigned less_mask(words4 const a, words4 const b) noexcept {
+  __m128i const reversed = _mm_shuffle_epi32(_mm_cmplt_epi32(a, b), _MM_SHUFFLE(0, 1, 2, 3));
+  return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(reversed)));
+}
+/// Returns true if all four pixels have an alpha value of 0xFF.
+[[nodiscard]] inline bool all_opaque(words4 const v) noexcept {
+  __m128i const t = _mm_or_si128(v, _mm_set1_epi32(0x00FFFFFF));
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(t, _mm_set1_epi32(-1))) == 0xFFFF;
+}
+inline void store_bytes8(std::byte* const DRAW_NONNULL dest, words4 const v) noexcept {
+  __m128i const t = _mm_packs_epi32(v, v);
+  auto const packed = _mm_cvtsi128_si32(_mm_packus_epi16(t, t));
+  std::memcpy(dest, &packed, 4);
+}
+inline void store_bytes16(std::byte* const DRAW_NONNULL dest, words4 const v) noexcept {
+  // Sign-extend each lane so that the signed saturating pack leaves the low 16 bits unchanged.
+  __m128i const t = _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dest), _mm_packs_epi32(t, t));  // NOLINT(*-reinterpret-cast)
+}
+inline void store_bytes24(std::byte* const DRAW_NONNULL dest, words4 const v) noexcept {
+  // Close the gap left by the alpha byte of the even lanes so that each 64-bit half holds six contiguous bytes.
+  __m128i const lo = _mm_and_si128(v, _mm_set_epi32(0, 0x00FFFFFF, 0, 0x00FFFFFF));
+  auto const hi_word = static_cast<int>(0xFF000000);
+  __m128i const hi_mask = _mm_set_epi32(0x0000FFFF, hi_word, 0x0000FFFF, hi_word);
+  __m128i const hi = _mm_and_si128(_mm_srli_epi64(v, 8), hi_mask);
+  std::array<std::byte, 16> t;
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(t.data()), _mm_or_si128(lo, hi));  // NOLINT(*-reinterpret-cast)
+  std::memcpy(dest, t.data(), 6);
+  std::memcpy(dest + 6, t.data() + 8, 6);
+}
+#elif DRAW_SPAN32_NEON
+using words4 = uint32x4_t;
+
+[[nodiscard]] inline words4 load_words(rgba_premult const* const DRAW_NONNULL p) noexcept {
+  return vreinterpretq_u32_u8(vld1q_u8(reinterpret_cast<std::uint8_t const*>(p)));  // NOLINT(*-reinterpret-cast)
+}
+[[nodiscard]] inline words4 load_words(std::uint32_t const* const DRAW_NONNULL p) noexcept {
+  return vld1q_u32(p);
+}
+[[nodiscard]] inline words4 splat_words(std::uint32_t const v) noexcept {
+  return vdupq_n_u32(v);
+}
+[[nodiscard]] inline words4 and_words(words4 const a, words4 const b) noexcept {
+  return vandq_u32(a, b);
+}
+[[nodiscard]] inline words4 or_words(words4 const a, words4 const b) noexcept {
+  return vorrq_u32(a, b);
+}
+[[nodiscard]] inline words4 add_words(words4 const a, words4 const b) noexcept {
+  return vaddq_u32(a, b);
+}
+[[nodiscard]] inline words4 mul_words(words4 const a, std::uint16_t const k) noexcept {
+  return vmulq_n_u32(a, k);
+}
+template <unsigned Shift> [[nodiscard]] inline words4 shl_words(words4 const v) noexcept {
+  return vshlq_n_u32(v, Shift);
+}
+template <unsigned Shift> [[nodiscard]] inline words4 shr_words(words4 const v) noexcept {
+  return vshrq_n_u32(v, Shift);
+}
+[[nodiscard]] inline words4 xor_words(words4 const a, words4 const b) noexcept {
+  return veorq_u32(a, b);
+}
+/// Returns a 4-bit mask with a bit set for each lane of \p a that is less than the corresponding lane of \p b. Lane 0
+/// is the most significant bit.
+[[nodiscard]] inline unsigned less_mask(words4 const a, words4 const b) noexcept {
+  static constexpr std::array<std::uint32_t, 4> weights{8, 4, 2, 1};
+  uint32x4_t const bits = vandq_u32(vcltq_u32(a, b), vld1q_u32(weights.data()));
+  uint32x2_t const sum = vpadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+  return vget_lane_u32(vpadd_u32(sum, sum), 0);
+}
+/// Returns true if all four pixels have an alpha value of 0xFF.
+[[nodiscard]] inline bool all_opaque(words4 const v) noexcept {
+  uint64x2_t const t = vreinterpretq_u64_u32(vorrq_u32(v, vdupq_n_u32(0x00FFFFFF)));
+  return (vgetq_lane_u64(t, 0) & vgetq_lane_u64(t, 1)) == ~std::uint64_t{0};
+}
+inline void store_bytes8(std::byte* const DRAW_NONNULL dest, words4 const v) noexcept {
+  uint16x4_t const t = vmovn_u32(v);
+  uint8x8_t const packed = vmovn_u16(vcombine_u16(t, t));
+  vst1_lane_u32(reinterpret_cast<std::uint32_t*>(dest), vreinterpret_u32_u8(packed), 0);  // NOLINT(*-reinterpret-cast)
+}
+inline void store_bytes16(std::byte* const DRAW_NONNULL dest, words4 const v) noexcept {
+  vst1_u16(reinterpret_cast<std::uint16_t*>(dest), vmovn_u32(v));  // NOLINT(*-reinterpret-cast)
+}
+inline void store_bytes24(std::byte* const DRAW_NONNULL dest, words4 const v) noexcept {
+  // Close the gap left by the alpha byte of the even lanes so that each 64-bit half holds six contiguous bytes.
+  uint64x2_t const w = vreinterpretq_u64_u32(v);
+  uint64x2_t const t = vorrq_u64(vandq_u64(w, vdupq_n_u64(0x0000'0000'00FF'FFFF)),
+                                 vandq_u64(vshrq_n_u64(w, 8), vdupq_n_u64(0x0000'FFFF'FF00'0000)));
+  std::array<std::byte, 16> b;
+  vst1q_u8(reinterpret_cast<std::uint8_t*>(b.data()), vreinterpretq_u8_u64(t));  // NOLINT(*-reinterpret-cast)
+  std::memcpy(dest, b.data(), 6);
+  std::memcpy(dest + 6, b.data() + 8, 6);
+}
+#else
+using words4 = std::array<std::uint32_t, 4>;
+
+[[nodiscard]] inline words4 load_words(rgba_premult const* const DRAW_NONNULL p) noexcept {
+  words4 result;
+  for (auto lane = 0U; lane < 4U; ++lane) {
+    result[lane] = static_cast<std::uint32_t>(p[lane].r) | (static_cast<std::uint32_t>(p[lane].g) << 8) |
+                   (static_cast<std::uint32_t>(p[lane].b) << 16) | (static_cast<std::uint32_t>(p[lane].a) << 24);
+  }
+  return result;
+}
+[[nodiscard]] inline words4 load_words(std::uint32_t const* const DRAW_NONNULL p) noexcept {
+  return {p[0], p[1], p[2], p[3]};
+}
+[[nodiscard]] inline words4 splat_words(std::uint32_t const v) noexcept {
+  return {v, v, v, v};
+}
+template <typename Function>
+[[nodiscard]] inline words4 map_words(words4 const& a, Function const f) noexcept {
+  words4 result;
+  std::ranges::transform(a, result.begin(), f);
+  return result;
+}
+[[nodiscard]] inline words4 and_words(words4 const& a, words4 const& b) noexcept {
+  words4 result;
+  std::ranges::transform(a, b, result.begin(), [](std::uint32_t x, std::uint32_t y) { return x & y; });
+  return result;
+}
+[[nodiscard]] inline words4 or_words(words4 const& a, words4 const& b) noexcept {
+  words4 result;
+  std::ranges::transform(a, b, result.begin(), [](std::uint32_t x, std::uint32_t y) { return x | y; });
+  return result;
+}
+[[nodiscard]] inline words4 add_words(words4 const& a, words4 const& b) noexcept {
+  words4 result;
+  std::ranges::transform(a, b, result.begin(), [](std::uint32_t x, std::uint32_t y) { return x + y; });
+  return result;
+}
+[[nodiscard]] inline words4 mul_words(words4 const& a, std::uint16_t const k) noexcept {
+  return map_words(a, [k](std::uint32_t x) { return x * k; });
+}
+template <unsigned Shift> [[nodiscard]] inline words4 shl_words(words4 const& v) noexcept {
+  return map_words(v, [](std::uint32_t x) { return x << Shift; });
+}
+template <unsigned Shift> [[nodiscard]] inline words4 shr_words(words4 const& v) noexcept {
+  return map_words(v, [](std::uint32_t x) { return x >> Shift; });
+}
+[[nodiscard]] inline words4 xor_words(words4 const& a, words4 const& b) noexcept {
+  words4 result;
+  std::ranges::transform(a, b, result.begin(), [](std::uint32_t x, std::uint32_t y) { return x ^ y; });
+  return result;
+}
+/// Returns a 4-bit mask with a bit set for each lane of \p a that is less than the corresponding lane of \p b. Lane 0
+/// is the most significant bit.
+[[nodiscard]] inline unsigned less_mask(words4 const& a, words4 const& b) noexcept {
+  auto result = 0U;
+  for (auto lane = 0U; lane < 4U; ++lane) {
+    result = (result << 1U) | static_cast<unsigned>(a[lane] < b[lane]);
+  }
+  return result;
+}
+/// Returns true if all four pixels have an alpha value of 0xFF.
+[[nodiscard]] inline bool all_opaque(words4 const& v) noexcept {
+  return std::ranges::all_of(v, [](std::uint32_t x) { return (x >> 24) == 0xFF; });
+}
+inline void store_bytes8(std::byte* DRAW_NONNULL dest, words4 const& v) noexcept {
+  for (auto const x : v) {
+    *(dest++) = static_cast<std::byte>(x);
+  }
+}
+inline void store_bytes16(std::byte* DRAW_NONNULL dest, words4 const& v) noexcept {
+  for (auto const x : v) {
+    *(dest++) = static_cast<std::byte>(x);
+    *(dest++) = static_cast<std::byte>(x >> 8);
+  }
+}
+inline void store_bytes24(std::byte* DRAW_NONNULL dest, words4 const& v) noexcept {
+  for (auto const x : v) {
+    *(dest++) = static_cast<std::byte>(x);
+    *(dest++) = static_cast<std::byte>(x >> 8);
+    *(dest++) = static_cast<std::byte>(x >> 16);
+  }
+}
+#endif  // DRAW_SPAN32_SSE2
+
+/// Returns the Rec. 601 luma of each pixel, with weights scaled to sum to 256, treating the pixels as if composited
+/// over black.
+[[nodiscard]] inline words4 luma_words(words4 const v) noexcept {
+  auto const r = mul_words(and_words(v, splat_words(0xFF)), 77);
+  auto const g = mul_words(and_words(shr_words<8>(v), splat_words(0xFF)), 150);
+  auto const b = mul_words(and_words(shr_words<16>(v), splat_words(0xFF)), 29);
+  return shr_words<8>(add_words(add_words(r, g), add_words(b, splat_words(0x80))));
+}
+/// The scalar equivalent of luma_words().
+[[nodiscard]] constexpr unsigned luma(rgba_premult const& px) noexcept {
+  return (77U * px.r + 150U * px.g + 29U * px.b + 0x80U) >> 8;
+}
+
+// The kernels
+// ~~~~~~~~~~~
+
+/// Composites the widened color \p src over the four pixels starting at \p dest where the corresponding lane of
+/// \p mask is set.
+inline void composite4(rgba_premult* const DRAW_NONNULL dest, channels8 const src, pixels4 const mask) noexcept {
+  pixels4 const d = load4(dest);
+  pixels4 const over = narrow(over8(src, widen_lo(d)), over8(src, widen_hi(d)));
+  store4(dest, select4(mask, over, d));
+}
+/// Composites a solid color over the eight pixels starting at \p dest where the corresponding lane of \p mask is set.
+///
+/// \param dest  The first of eight destination pixels.
+/// \param color  The color to be composited.
+/// \param mask  Selects the pixels to be modified.
+inline void composite8(rgba_premult* const DRAW_NONNULL dest, rgba_premult const& color,
+                       lane_mask8 const& mask) noexcept {
+  channels8 const src = widen_lo(splat4(color));
+  composite4(dest, src, load_mask4(mask.data()));
+  composite4(dest + 4, src, load_mask4(mask.data() + 4));
+}
+/// Composites a solid color over the eight pixels starting at \p dest where the corresponding bit of \p bits is set.
+/// The most significant bit corresponds to the first pixel.
+inline void composite8(rgba_premult* const DRAW_NONNULL dest, rgba_premult const& color,
+                       std::uint8_t const bits) noexcept {
+  channels8 const src = widen_lo(splat4(color));
+  composite4(dest, src, mask4_from_bits(bits >> 4U));
+  composite4(dest + 4, src, mask4_from_bits(bits & 0x0FU));
+}
+/// Composites a solid color over fewer than eight pixels starting at \p dest where the corresponding lane of \p mask
+/// is set. The pixels go via a temporary so that the kernel never touches memory beyond the run.
+///
+/// \param dest  The first pixel of the run.
+/// \param count  The number of pixels in the run. Must be less than 8.
+/// \param color  The color to be composited.
+/// \param mask  Selects the pixels to be modified.
+inline void composite_partial(rgba_premult* const DRAW_NONNULL dest, std::size_t const count, rgba_premult const& color,
+                              lane_mask8 const& mask) noexcept {
+  assert(count < 8U);
+  std::array<rgba_premult, 8> tail{};
+  std::copy_n(dest, count, tail.begin());
+  composite8(tail.data(), color, mask);
+  std::copy_n(tail.begin(), count, dest);
+}
+
+/// Composites a solid color over a run of pixels. The same lane mask is applied to each successive block of eight
+/// pixels, so lane 0 of \p mask corresponds to the first pixel of the run.
+///
+/// \param dest  The first pixel of the run.
+/// \param count  The number of pixels in the run.
+/// \param color  The color to be composited.
+/// \param mask  Selects the pixels to be modified in each block of eight.
+inline void composite_span(rgba_premult* DRAW_NONNULL dest, std::size_t count, rgba_premult const& color,
+                           lane_mask8 const& mask) noexcept {
+  for (; count >= 8U; count -= 8U) {
+    composite8(dest, color, mask);
+    dest += 8;
+  }
+  if (count > 0U) {
+    composite_partial(dest, count, color, mask);
+  }
+}
+
+/// Composites a solid color, scaled by a per-pixel coverage value, over a run of pixels. Blocks of four uncovered
+/// pixels are skipped and fully covered blocks of an opaque color are simply stored.
+///
+/// \param dest  The first pixel of the run.
+/// \param count  The number of pixels in the run.
+/// \param coverage  The coverage of each pixel of the run: 0 leaves the pixel unchanged and 0xFF applies \p color in
+///   full.
+/// \param color  The color to be composited.
+inline void composite_coverage(rgba_premult* DRAW_NONNULL dest, std::size_t count,
+                               std::uint8_t const* DRAW_NONNULL coverage, rgba_premult const& color) noexcept {
+  channels8 const src = widen_lo(splat4(color));
+  auto const kernel = [&src, &color](rgba_premult* const DRAW_NONNULL d, std::uint8_t const* const DRAW_NONNULL c) {
+    std::uint32_t block = 0;
+    std::memcpy(&block, c, sizeof(block));
+    if (block == 0U) {
+      return;
+    }
+    if (block == 0xFFFF'FFFFU && color.a == 0xFFU) {
+      store4(d, splat4(color));
+      return;
+    }
+    pixels4 const cov = load_coverage4(c);
+    pixels4 const px = load4(d);
+    channels8 const lo = over8(mul255(src, widen_lo(cov)), widen_lo(px));
+    channels8 const hi = over8(mul255(src, widen_hi(cov)), widen_hi(px));
+    store4(d, narrow(lo, hi));
+  };
+  for (; count >= 4U; count -= 4U) {
+    kernel(dest, coverage);
+    dest += 4;
+    coverage += 4;
+  }
+  if (count > 0U) {
+    // The final partial block goes via temporaries so that the kernel never touches memory beyond the run.
+    std::array<rgba_premult, 4> d{};
+    std::array<std::uint8_t, 4> c{};
+    std::copy_n(dest, count, d.begin());
+    std::copy_n(coverage, count, c.begin());
+    kernel(d.data(), c.data());
+    std::copy_n(d.begin(), count, dest);
+  }
+}
+
+/// Returns the eight pixels of a 1bpp row starting at x-ordinate \p x. The pixel at \p x is in the most significant
+/// bit. Pixels beyond the end of the row are zero.
+[[nodiscard]] constexpr std::uint8_t fetch8(std::span<std::byte const> const row, unsigned const x) noexcept {
+  auto const index = x / 8U;
+  assert(index < row.size());
+  auto v = std::to_integer<unsigned>(row[index]) << 8U;
+  if (index + 1U < row.size()) {
+    v |= std::to_integer<unsigned>(row[index + 1U]);
+  }
+  return static_cast<std::uint8_t>((v << (x % 8U)) >> 8U);
+}
+
+/// Composites a solid color over a run of pixels wherever the corresponding pixel of a 1bpp source row is set. Each
+/// block of eight source pixels is expanded to a lane mask in turn, so no intermediate 32-bit image is required.
+///
+/// \param dest  The first pixel of the destination run.
+/// \param count  The number of pixels in the run.
+/// \param src_row  A row of 1bpp pixels with the most significant bit of each byte leftmost.
+/// \param src_x  The x-ordinate within \p src_row of the pixel corresponding to \p dest.
+/// \param color  The color to be composited.
+inline void composite_bits(rgba_premult* DRAW_NONNULL dest, std::size_t count, std::span<std::byte const> const src_row,
+                           unsigned src_x, rgba_premult const& color) noexcept {
+  for (; count >= 8U; count -= 8U) {
+    // Runs of clear pixels are common (the space around a glyph, for example) so they are skipped a byte at a time.
+    if (auto const bits = fetch8(src_row, src_x); bits != 0U) {
+      composite8(dest, color, bits);
+    }
+    dest += 8;
+    src_x += 8U;
+  }
+  if (count > 0U) {
+    auto const bits = static_cast<std::uint8_t>(fetch8(src_row, src_x) & ~(0xFFU >> count));
+    composite_partial(dest, count, color, expand_mask(bits));
+  }
+}
+
+/// Writes \p fg to each of a run of pixels where the corresponding pixel of a 1bpp source row is set and \p bg where
+/// it is clear. The destination pixels are not read.
+///
+/// \param dest  The first pixel of the destination run.
+/// \param count  The number of pixels in the run.
+/// \param src_row  A row of 1bpp pixels with the most significant bit of each byte leftmost.
+/// \param src_x  The x-ordinate within \p src_row of the pixel corresponding to \p dest.
+/// \param fg  The color of set pixels.
+/// \param bg  The color of clear pixels.
+inline void expand_bits(rgba_premult* DRAW_NONNULL dest, std::size_t count, std::span<std::byte const> const src_row,
+                        unsigned src_x, rgba_premult const& fg, rgba_premult const& bg) noexcept {
+  pixels4 const f = splat4(fg);
+  pixels4 const b = splat4(bg);
+  auto const expand8 = [&f, &b](rgba_premult* const DRAW_NONNULL p, unsigned const bits) {
+    store4(p, select4(mask4_from_bits(bits >> 4U), f, b));
+    store4(p + 4, select4(mask4_from_bits(bits & 0x0FU), f, b));
+  };
+  for (; count >= 8U; count -= 8U) {
+    expand8(dest, fetch8(src_row, src_x));
+    dest += 8;
+    src_x += 8U;
+  }
+  if (count > 0U) {
+    std::array<rgba_premult, 8> tail;
+    expand8(tail.data(), fetch8(src_row, src_x));
+    std::copy_n(tail.begin(), count, dest);
+  }
+}
+
+// Linear light
+// ~~~~~~~~~~~~
+// Blending in linear light converts each channel from sRGB to a 16-bit linear value, blends, and converts the result
+// back. Both conversions are table lookups: calling pow() for each channel would cost several times the blend itself.
+// The 4096-entry table that converts back to sRGB is indexed by the top 12 bits of the linear value.
+
+/// The reciprocal of each alpha value scaled by 2^24 and rounded up. Multiplying by an entry and shifting right by 24
+/// gives the exact quotient for any dividend below 2^16.
+inline constexpr auto reciprocals = [] {
+  std::array<std::uint32_t, 256> result{};
+  for (auto a = 1U; a < result.size(); ++a) {
+    result[a] = ((std::uint32_t{1} << 24) + a - 1U) / a;
+  }
+  return result;
+}();
+
+/// Undoes the premultiplication of color channel \p c by alpha \p a. The result is identical to that of
+/// rgba_premult::to_straight().
+[[nodiscard]] constexpr std::uint8_t unpremultiply(std::uint8_t const c, std::uint8_t const a) noexcept {
+  auto const n = static_cast<std::uint64_t>(c * 0xFFU + a / 2U);
+  return static_cast<std::uint8_t>(std::min((n * reciprocals[a]) >> 24, std::uint64_t{0xFF}));
+}
+
+/// Decodes an sRGB value in the range [0, 1] to linear light. x^2.4 is computed as x^2 * (x^2)^(1/5) with the fifth
+/// root found by Newton's method so that the tables can be built at compile time.
+[[nodiscard]] constexpr double srgb_decode(double const v) noexcept {
+  if (v <= 0.04045) {
+    return v / 12.92;
+  }
+  auto const x = (v + 0.055) / 1.055;
+  auto const x2 = x * x;
+  auto root = 1.0;
+  for (auto iteration = 0; iteration < 64; ++iteration) {
+    root = (4.0 * root + x2 / (root * root * root * root)) / 5.0;
+  }
+  return x2 * root;
+}
+
+/// The 16-bit linear value of each 8-bit sRGB value.
+inline constexpr auto srgb_to_linear = [] {
+  std::array<std::uint16_t, 256> result{};
+  for (auto c = 0U; c < result.size(); ++c) {
+    result[c] = static_cast<std::uint16_t>(srgb_decode(c / 255.0) * 65535.0 + 0.5);
+  }
+  return result;
+}();
+
+/// The 8-bit sRGB value whose linear value is nearest to the middle of each 16-entry bucket of 16-bit linear values.
+inline constexpr auto linear_to_srgb = [] {
+  std::array<std::uint8_t, 4096> result{};
+  auto c = 0U;
+  for (auto index = 0U; index < result.size(); ++index) {
+    auto const target = index * 16U + 8U;
+    while (c < 0xFFU && (srgb_to_linear[c] + srgb_to_linear[c + 1U]) / 2U < target) {
+      ++c;
+    }
+    result[index] = static_cast<std::uint8_t>(c);
+  }
+  return result;
+}();
+
+/// \returns The straight 16-bit linear value of the premultiplied sRGB channel \p c with alpha \p a.
+[[nodiscard]] constexpr unsigned to_linear(std::uint8_t const c, std::uint8_t const a) noexcept {
+  if (a == 0xFFU) {
+    return srgb_to_linear[c];
+  }
+  return a == 0U ? 0U : srgb_to_linear[unpremultiply(c, a)];
+}
+
+/// Composites \p src over \p dest in linear light one channel at a time. The blend uses the same arithmetic as
+/// over_linear4() so that the two produce identical results for an opaque destination.
+[[nodiscard]] constexpr rgba_premult over_linear(rgba_premult const& src, rgba_premult const& dest) noexcept {
+  if (src.a == 0U) {
+    return dest;
+  }
+  if (src.a == 0xFFU) {
+    return src;
+  }
+  auto const div255 = [](unsigned const x) { return (x + 0x80U + (x >> 8U)) >> 8U; };
+  auto const mulhi = [](unsigned const x, unsigned const y) { return (x * y) >> 16U; };
+  auto const ws = src.a * 0x101U;
+  auto const out_a = src.a + div255(dest.a * (0xFFU - src.a));
+  auto const channel = [&](std::uint8_t const s, std::uint8_t const d) {
+    auto ld = to_linear(d, dest.a);
+    if (dest.a != 0xFFU) {
+      ld = mulhi(ld, dest.a * 0x101U);
+    }
+    auto p = mulhi(to_linear(s, src.a), ws) + mulhi(ld, 0xFFFFU - ws);
+    if (out_a != 0xFFU) {
+      p = std::min(p * 0xFFU / out_a, 0xFFFFU);
+    }
+    auto const c = linear_to_srgb[p >> 4U];
+    return static_cast<std::uint8_t>(out_a == 0xFFU ? c : div255(c * out_a));
+  };
+  return {channel(src.r, dest.r), channel(src.g, dest.g), channel(src.b, dest.b), static_cast<std::uint8_t>(out_a)};
+}
+
+/// Composites four source pixels over four destination pixels in linear light. The table lookups are scalar (there
+/// is no portable gather) but the weighted sum is computed a vector at a time when the destination is opaque, which
+/// is the usual case for a frame buffer.
+inline void over_linear4(rgba_premult* const DRAW_NONNULL dest, rgba_premult const* const DRAW_NONNULL src) noexcept {
+  if (all_opaque(load_words(src))) {
+    std::copy_n(src, 4, dest);
+    return;
+  }
+  if (!all_opaque(load_words(dest))) {
+    for (auto index = 0U; index < 4U; ++index) {
+      dest[index] = over_linear(src[index], dest[index]);
+    }
+    return;
+  }
+  // Lanes are laid out as pixels: the alpha lanes are zero and their result ignored.
+  std::array<std::uint16_t, 16> ls{};
+  std::array<std::uint16_t, 16> ld{};
+  std::array<std::uint16_t, 16> ws{};
+  std::array<std::uint16_t, 16> wd{};
+  for (auto index = 0U; index < 4U; ++index) {
+    auto const s = std::bit_cast<std::array<std::uint8_t, 4>>(src[index]);
+    auto const d = std::bit_cast<std::array<std::uint8_t, 4>>(dest[index]);
+    for (auto ch = 0U; ch < 3U; ++ch) {
+      auto const lane = index * 4U + ch;
+      ls[lane] = static_cast<std::uint16_t>(to_linear(s[ch], src[index].a));
+      ld[lane] = srgb_to_linear[d[ch]];
+      ws[lane] = static_cast<std::uint16_t>(src[index].a * 0x101U);
+      wd[lane] = static_cast<std::uint16_t>(0xFFFFU - ws[lane]);
+    }
+  }
+  std::array<std::uint16_t, 16> p{};
+  for (auto half = 0U; half < 16U; half += 8U) {
+    store16(&p[half], add8(mulhi8(load16(&ls[half]), load16(&ws[half])),
+                           mulhi8(load16(&ld[half]), load16(&wd[half]))));
+  }
+  for (auto index = 0U; index < 4U; ++index) {
+    // Transparent and opaque source pixels must leave the destination and copy the source exactly.
+    if (src[index].a == 0xFFU) {
+      dest[index] = src[index];
+    } else if (src[index].a != 0U) {
+      auto const lane = index * 4U;
+      dest[index] = rgba_premult{linear_to_srgb[p[lane] >> 4U], linear_to_srgb[p[lane + 1U] >> 4U],
+                                 linear_to_srgb[p[lane + 2U] >> 4U]};
+    }
+  }
+}
+
+/// Combines two pixels held in \p src and \p dest using the compositing operator given by \p Mode. Every formula
+/// works on premultiplied values and applies uniformly to the color and alpha channels.
+template <bitmap32::transfer_mode Mode>
+[[nodiscard]] inline channels8 blend8(channels8 const src, channels8 const dest) noexcept {
+  using enum bitmap32::transfer_mode;
+  channels8 const one = splat8(0xFF);
+  if constexpr (Mode == mode_clear) {
+    return splat8(0);
+  } else if constexpr (Mode == mode_src) {
+    return src;
+  } else if constexpr (Mode == mode_src_over) {
+    return over8(src, dest);
+  } else if constexpr (Mode == mode_dst_over) {
+    return over8(dest, src);
+  } else if constexpr (Mode == mode_src_in) {
+    return mul255(src, alpha8(dest));
+  } else if constexpr (Mode == mode_dst_out) {
+    return mul255(dest, sub8(one, alpha8(src)));
+  } else {
+    // The remaining operators all include the parts of the source and destination that lie outside the other.
+    channels8 const outside = add8(mul255(src, sub8(one, alpha8(dest))), mul255(dest, sub8(one, alpha8(src))));
+    if constexpr (Mode == mode_xor) {
+      return outside;
+    } else if constexpr (Mode == mode_multiply) {
+      return add8(mul255(src, dest), outside);
+    } else if constexpr (Mode == mode_screen) {
+      return sub8(add8(src, dest), mul255(src, dest));
+    } else if constexpr (Mode == mode_darken) {
+      return add8(min8(mul255(src, alpha8(dest)), mul255(dest, alpha8(src))), outside);
+    } else {
+      static_assert(Mode == mode_lighten, "unknown transfer mode");
+      return add8(max8(mul255(src, alpha8(dest)), mul255(dest, alpha8(src))), outside);
+    }
+  }
+}
+
+/// Combines a row of source pixels with a row of destination pixels using the compositing operator given by \p Mode.
+/// Each operator produces a separate instantiation so there is no per-pixel dispatch.
+///
+/// \param dest  The first pixel of the destination row.
+/// \param src  The first pixel of the source row.
+/// \param count  The number of pixels in the row.
+template <bitmap32::transfer_mode Mode>
+void blend_row(rgba_premult* DRAW_NONNULL dest, rgba_premult const* DRAW_NONNULL src, std::size_t count) noexcept {
+  for (; count >= 4U; count -= 4U) {
+    if constexpr (Mode == bitmap32::transfer_mode::mode_src_over_linear) {
+      over_linear4(dest, src);
+    } else {
+      pixels4 const s = load4(src);
+      pixels4 const d = load4(dest);
+      store4(dest, narrow(blend8<Mode>(widen_lo(s), widen_lo(d)), blend8<Mode>(widen_hi(s), widen_hi(d))));
+    }
+    src += 4;
+    dest += 4;
+  }
+  if (count > 0U) {
+    // The final partial block goes via temporaries so that the kernel never touches pixels beyond the row.
+    std::array<rgba_premult, 4> s{};
+    std::array<rgba_premult, 4> d{};
+    std::copy_n(src, count, s.begin());
+    std::copy_n(dest, count, d.begin());
+    blend_row<Mode>(d.data(), s.data(), d.size());
+    std::copy_n(d.begin(), count, dest);
+  }
+}
+
+}  // end namespace draw::details
+
+#endif  // DRAW_SPAN32_HPP
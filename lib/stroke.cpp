@@ -0,0 +1,340 @@
+//===- lib/stroke.cpp -----------------------------------------------------===//
+//*      _             _         *
+//*  ___| |_ _ __ ___ | | _____  *
+//* / __| __| '__/ _ \| |/ / _ \ *
+//* \__ \ |_| | | (_) |   <  __/ *
+//* |___/\__|_|  \___/|_|\_\___| *
+//*                              *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+#include "draw/bitmap32.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+
+// Local includes
+#include "draw/types.hpp"
+#include "span32.hpp"
+
+namespace {
+
+using stroke_style = draw::bitmap32::stroke_style;
+using line_cap = draw::bitmap32::line_cap;
+using line_join = draw::bitmap32::line_join;
+
+// The stroker describes the outline of a stroke as a collection of simple convex pieces: one for the body of each
+// segment and one for each join and cap. The pieces may overlap. For each row of pixels, every piece is reduced to
+// the range of columns that it covers and those ranges are merged before anything is painted.
+
+struct vec {
+  float x = 0.0F;
+  float y = 0.0F;
+};
+constexpr vec operator+(vec const a, vec const b) noexcept {
+  return {.x = a.x + b.x, .y = a.y + b.y};
+}
+constexpr vec operator-(vec const a, vec const b) noexcept {
+  return {.x = a.x - b.x, .y = a.y - b.y};
+}
+constexpr vec operator*(vec const a, float const k) noexcept {
+  return {.x = a.x * k, .y = a.y * k};
+}
+constexpr float dot(vec const a, vec const b) noexcept {
+  return a.x * b.x + a.y * b.y;
+}
+constexpr float cross(vec const a, vec const b) noexcept {
+  return a.x * b.y - a.y * b.x;
+}
+constexpr vec to_vec(draw::point const p) noexcept {
+  return {.x = static_cast<float>(p.x), .y = static_cast<float>(p.y)};
+}
+/// \returns The normal of a unit vector: the vector rotated a quarter turn clockwise on screen.
+constexpr vec normal(vec const u) noexcept {
+  return {.x = -u.y, .y = u.x};
+}
+
+/// The tolerance used when a piece's edge passes through (or very close to) the center of a pixel.
+constexpr auto epsilon = 1.0F / 1024.0F;
+/// The amount by which the open side of a half-open range is pulled in.
+constexpr auto open_bias = 1.0F / 64.0F;
+/// The ratio of the length of a miter to half of the stroke width beyond which the join is beveled instead.
+constexpr auto miter_limit = 4.0F;
+
+/// A range of columns covered by a piece on a row. The range is empty if lo > hi.
+struct extent {
+  float lo = std::numeric_limits<float>::infinity();
+  float hi = -std::numeric_limits<float>::infinity();
+
+  [[nodiscard]] static constexpr extent all() noexcept { return {.lo = -infinity, .hi = infinity}; }
+  [[nodiscard]] constexpr extent intersect(extent const& other) const noexcept {
+    return {.lo = std::max(lo, other.lo), .hi = std::min(hi, other.hi)};
+  }
+  constexpr void include(float const x) noexcept {
+    lo = std::min(lo, x);
+    hi = std::max(hi, x);
+  }
+
+private:
+  static constexpr auto infinity = std::numeric_limits<float>::infinity();
+};
+
+/// \returns The values of x for which lo <= a * x + b <= hi.
+constexpr extent solve(float const a, float const b, float const lo, float const hi) noexcept {
+  if (std::abs(a) < epsilon * epsilon) {
+    return b >= lo && b <= hi ? extent::all() : extent{};
+  }
+  auto const x0 = (lo - b) / a;
+  auto const x1 = (hi - b) / a;
+  return a > 0.0F ? extent{.lo = x0, .hi = x1} : extent{.lo = x1, .hi = x0};
+}
+
+/// A rectangle aligned with a segment: the points whose distance along the segment from its start is between
+/// t_lo and t_hi and whose distance from the center-line is at most half of the stroke width.
+struct band {
+  vec start;
+  vec u;  ///< The unit direction of the segment
+  float t_lo;
+  float t_hi;
+  float half;
+
+  [[nodiscard]] constexpr extent on_row(float const y) const noexcept {
+    auto const ry = y - start.y;
+    // The distance from the center-line is half-open so that a stroke of even width covers exactly that many rows
+    // (or columns) of an axis-aligned segment. The open side is chosen so that the extra pixel always lies above or
+    // to the left of the center-line whichever way the segment runs.
+    auto const n = normal(u);
+    auto const open_positive = n.y > 0.0F || (n.y == 0.0F && n.x > 0.0F);
+    auto const lo = open_positive ? -half : -half + open_bias;
+    auto const hi = open_positive ? half - open_bias : half;
+    return solve(u.x, ry * u.y - start.x * u.x, t_lo, t_hi).intersect(solve(-u.y, ry * u.x + start.x * u.y, lo, hi));
+  }
+};
+
+/// A circle used for round caps and joins.
+struct disc {
+  vec center;
+  float radius;
+
+  [[nodiscard]] extent on_row(float const y) const noexcept {
+    auto const dy = y - center.y;
+    auto const q = radius * radius - dy * dy;
+    if (q < 0.0F) {
+      return {};
+    }
+    auto const s = std::sqrt(q);
+    return {.lo = center.x - s, .hi = center.x + s};
+  }
+};
+
+/// A convex polygon of three or four vertices used for beveled and mitered joins.
+struct polygon {
+  std::array<vec, 4> v;
+  std::size_t size;
+
+  [[nodiscard]] constexpr extent on_row(float const y) const noexcept {
+    extent result;
+    for (auto n = std::size_t{0}; n < size; ++n) {
+      auto const a = v[n];
+      auto const b = v[(n + 1U) % size];
+      if (y < std::min(a.y, b.y) - epsilon || y > std::max(a.y, b.y) + epsilon) {
+        continue;
+      }
+      if (std::abs(b.y - a.y) < epsilon) {
+        result.include(a.x);
+        result.include(b.x);
+        continue;
+      }
+      auto const t = std::clamp((y - a.y) / (b.y - a.y), 0.0F, 1.0F);
+      result.include(a.x + t * (b.x - a.x));
+    }
+    return result;
+  }
+};
+
+/// Passes the pieces of the join at vertex \p p between a segment with direction \p u0 and the following segment
+/// with direction \p u1 to \p f.
+template <typename Function>
+void join_pieces(vec const p, vec const u0, vec const u1, stroke_style const& style, Function const& f) {
+  auto const half = static_cast<float>(style.width) / 2.0F;
+  if (style.join == line_join::round) {
+    f(disc{.center = p, .radius = half});
+    return;
+  }
+  auto const turn = cross(u0, u1);
+  if (std::abs(turn) < epsilon) {
+    return;  // The segments are collinear so their bodies already meet.
+  }
+  // The join fills the gap between the segments' outer edges: those on the opposite side to the turn.
+  auto const side = turn > 0.0F ? -half : half;
+  auto const n0 = normal(u0);
+  auto const n1 = normal(u1);
+  auto const a = p + n0 * side;
+  auto const b = p + n1 * side;
+  auto const cos_turn = dot(n0, n1);
+  // The miter's length relative to half of the width is sqrt(2 / (1 + cos_turn)).
+  if (style.join == line_join::miter && 1.0F + cos_turn >= 2.0F / (miter_limit * miter_limit)) {
+    auto const m = p + (n0 + n1) * (side / (1.0F + cos_turn));
+    f(polygon{.v = {p, a, m, b}, .size = 4U});
+    return;
+  }
+  f(polygon{.v = {p, a, b, vec{}}, .size = 3U});
+}
+
+/// Passes the cap at end point \p p of a segment with direction \p u to \p f. \p u points away from the stroke.
+template <typename Function> void cap_pieces(vec const p, vec const u, stroke_style const& style, Function const& f) {
+  auto const half = static_cast<float>(style.width) / 2.0F;
+  switch (style.cap) {
+  case line_cap::butt: break;
+  case line_cap::square: f(band{.start = p, .u = u, .t_lo = 0.0F, .t_hi = half, .half = half}); break;
+  case line_cap::round: f(disc{.center = p, .radius = half}); break;
+  }
+}
+
+/// Passes every piece of a stroke to \p f. Zero-length segments are ignored.
+template <typename Function>
+void for_each_piece(std::span<draw::point const> const points, stroke_style const& style, bool const closed,
+                    Function const& f) {
+  auto const half = static_cast<float>(style.width) / 2.0F;
+  struct segment {
+    vec start;
+    vec end;
+    vec u;
+  };
+  std::optional<segment> first;
+  std::optional<segment> previous;
+  auto const visit = [&](draw::point const from, draw::point const to) {
+    if (from == to) {
+      return;
+    }
+    auto const start = to_vec(from);
+    auto const end = to_vec(to);
+    auto const d = end - start;
+    auto const length = std::sqrt(dot(d, d));
+    auto const s = segment{.start = start, .end = end, .u = d * (1.0F / length)};
+    f(band{.start = start, .u = s.u, .t_lo = 0.0F, .t_hi = length, .half = half});
+    if (previous) {
+      join_pieces(start, previous->u, s.u, style, f);
+    } else {
+      first = s;
+    }
+    previous = s;
+  };
+  for (auto n = std::size_t{1}; n < points.size(); ++n) {
+    visit(points[n - 1U], points[n]);
+  }
+  if (closed && points.size() > 2U) {
+    visit(points.back(), points.front());
+  }
+
+  if (!first) {
+    // Every point is the same: a round or square cap is drawn as a dot.
+    auto const p = to_vec(points.front());
+    if (style.cap == line_cap::round) {
+      f(disc{.center = p, .radius = half});
+    } else if (style.cap == line_cap::square) {
+      f(band{.start = p, .u = vec{.x = 1.0F, .y = 0.0F}, .t_lo = -half, .t_hi = half - open_bias, .half = half});
+    }
+    return;
+  }
+  if (closed) {
+    join_pieces(first->start, previous->u, first->u, style, f);
+  } else {
+    cap_pieces(first->start, first->u * -1.0F, style, f);
+    cap_pieces(previous->end, previous->u, style, f);
+  }
+}
+
+/// The number of columns whose coverage is gathered before painting. Wider rows are processed in several pieces.
+constexpr auto stroke_chunk = 256U;
+
+}  // end anonymous namespace
+
+namespace draw {
+
+void bitmap32::stroke_polyline(std::span<point const> const points, stroke_style const& style, rgba const& color,
+                               bool const closed) {
+  if (points.empty() || style.width == 0U) {
+    return;
+  }
+  // A conservative bounding box: no part of the stroke lies further from a vertex than the longest miter.
+  auto const reach = static_cast<int>(std::ceil(static_cast<float>(style.width) / 2.0F * miter_limit)) + 1;
+  auto const [min_x, max_x] = std::ranges::minmax(points | std::views::transform(&point::x));
+  auto const [min_y, max_y] = std::ranges::minmax(points | std::views::transform(&point::y));
+  auto const left = std::max(min_x - reach, 0);
+  auto const top = std::max(min_y - reach, 0);
+  auto const right = std::min(max_x + reach, static_cast<int>(width_) - 1);
+  auto const bottom = std::min(max_y + reach, static_cast<int>(height_) - 1);
+
+  auto const c = rgba_premult{color};
+  auto const mask = details::expand_mask(0xFF);
+  std::optional<rect> painted;
+  std::array<bool, stroke_chunk> covered{};
+  for (auto y = top; y <= bottom; ++y) {
+    auto* const row = &store_[static_cast<std::size_t>(y) * stride_];
+    for (auto x0 = left; x0 <= right; x0 += static_cast<int>(stroke_chunk)) {
+      auto const x1 = std::min(x0 + static_cast<int>(stroke_chunk) - 1, right);
+      std::ranges::fill(covered, false);
+      for_each_piece(points, style, closed, [&](auto const& piece) {
+        auto const e = piece.on_row(static_cast<float>(y));
+        auto const first = std::max(static_cast<int>(std::ceil(std::max(e.lo - epsilon, static_cast<float>(x0)))), x0);
+        auto const last = std::min(static_cast<int>(std::floor(std::min(e.hi + epsilon, static_cast<float>(x1)))), x1);
+        if (first <= last) {
+          std::fill(&covered[first - x0], &covered[last - x0] + 1, true);
+        }
+      });
+      // Paint each run of covered pixels.
+      for (auto x = x0; x <= x1;) {
+        if (!covered[x - x0]) {
+          ++x;
+          continue;
+        }
+        auto const start = x;
+        while (x <= x1 && covered[x - x0]) {
+          ++x;
+        }
+        details::composite_span(row + start, static_cast<std::size_t>(x - start), c, mask);
+        auto const run = rect{.top = static_cast<coordinate>(y),
+                              .left = static_cast<coordinate>(start),
+                              .bottom = static_cast<coordinate>(y),
+                              .right = static_cast<coordinate>(x - 1)};
+        painted = painted ? painted->union_rect(run) : run;
+      }
+    }
+  }
+  if (painted) {
+    this->mark_dirty(*painted);
+  }
+}
+
+}  // end namespace draw
@@ -0,0 +1,145 @@
+//===- unit_tests/test_basic_bitmap.cpp -----------------------------------===//
+//*  _               _        _     _ _                          *
+//* | |__   __ _ ___(_) ___  | |__ (_) |_ _ __ ___   __ _ _ __   *
+//* | '_ \ / _` / __| |/ __| | '_ \| | __| '_ ` _ \ / _` | '_ \  *
+//* | |_) | (_| \__ \ | (__  | |_) | | |_| | | | | | (_| | |_) | *
+//* |_.__/ \__,_|___/_|\___| |_.__/|_|\__|_| |_| |_|\__,_| .__/  *
+//*                                                      |_|     *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/basic_bitmap.hpp"
+#include "draw/gray_bitmap.hpp"
+#include "draw/indexed8_bitmap.hpp"
+
+// Standard library
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using testing::Each;
+using testing::ElementsAre;
+using namespace draw::literals;
+
+namespace {
+
+template <typename Bitmap>
+std::tuple<std::vector<typename Bitmap::storage_type>, Bitmap> create(std::uint16_t const width,
+                                                                      std::uint16_t const height) {
+  std::vector store(Bitmap::required_store_size(width, height), typename Bitmap::storage_type{});
+  return std::tuple(std::move(store), Bitmap{std::span{store}, width, height});
+}
+
+TEST(PackedFormat, ExpandPattern) {
+  EXPECT_THAT(draw::gray2_format::expand_pattern(0b1001'0110_b), ElementsAre(0b1100'0011_b, 0b0011'1100_b));
+  EXPECT_THAT(draw::gray4_format::expand_pattern(0b1001'0110_b),
+              ElementsAre(0xF0_b, 0x0F_b, 0x0F_b, 0xF0_b));
+  EXPECT_THAT(draw::mono_format::expand_pattern(0b1001'0110_b), ElementsAre(0b1001'0110_b));
+}
+
+TEST(BasicBitmap, Gray2RequiredStride) {
+  EXPECT_EQ(draw::gray2_bitmap::required_stride(1U), 1U);
+  EXPECT_EQ(draw::gray2_bitmap::required_stride(4U), 1U);
+  EXPECT_EQ(draw::gray2_bitmap::required_stride(5U), 2U);
+  EXPECT_EQ(draw::gray4_bitmap::required_stride(3U), 2U);
+  EXPECT_EQ(draw::rgb565_bitmap::required_stride(3U), 3U);
+}
+
+TEST(BasicBitmap, Gray2SetAndGet) {
+  auto [store, bmp] = create<draw::gray2_bitmap>(6U, 1U);
+  bmp.set(draw::point{.x = 0, .y = 0}, 3U);
+  bmp.set(draw::point{.x = 1, .y = 0}, 2U);
+  bmp.set(draw::point{.x = 5, .y = 0}, 1U);
+  bmp.set(draw::point{.x = 6, .y = 0}, 3U);  // Outside the bitmap.
+  EXPECT_THAT(store, ElementsAre(0b1110'0000_b, 0b0001'0000_b));
+  EXPECT_EQ(bmp.get(draw::point{.x = 1, .y = 0}), 2U);
+  EXPECT_EQ(bmp.get(draw::point{.x = 2, .y = 0}), 0U);
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 0, .left = 0, .bottom = 0, .right = 5}));
+}
+
+TEST(BasicBitmap, Gray4HorizontalLine) {
+  auto [store, bmp] = create<draw::gray4_bitmap>(8U, 2U);
+  bmp.line(draw::point{.x = 1, .y = 1}, draw::point{.x = 6, .y = 1}, 0xAU);
+  EXPECT_THAT(store, ElementsAre(0x00_b, 0x00_b, 0x00_b, 0x00_b,  // [0]
+                                 0x0A_b, 0xAA_b, 0xAA_b, 0xA0_b   // [1]
+                                 ));
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 1, .left = 1, .bottom = 1, .right = 6}));
+}
+
+TEST(BasicBitmap, Gray2DiagonalLine) {
+  auto [store, bmp] = create<draw::gray2_bitmap>(4U, 4U);
+  bmp.line(draw::point{.x = 0, .y = 0}, draw::point{.x = 3, .y = 3}, 1U);
+  EXPECT_THAT(store, ElementsAre(0b0100'0000_b, 0b0001'0000_b, 0b0000'0100_b, 0b0000'0001_b));
+}
+
+TEST(BasicBitmap, Gray2PaintRectWithBackground) {
+  auto [store, bmp] = create<draw::gray2_bitmap>(8U, 2U);
+  std::ranges::fill(store, 0xFF_b);
+  bmp.paint_rect(draw::rect{.top = 0, .left = 1, .bottom = 1, .right = 6}, draw::gray, 2U, 1U);
+  // The gray pattern is 0xAA on even rows and 0x55 on odd rows.
+  EXPECT_THAT(store, ElementsAre(0b1101'1001_b, 0b1001'1011_b,  // [0]
+                                 0b1110'0110_b, 0b0110'0111_b   // [1]
+                                 ));
+}
+
+TEST(BasicBitmap, Gray4PaintRectTransparentBackground) {
+  auto [store, bmp] = create<draw::gray4_bitmap>(4U, 1U);
+  std::ranges::fill(store, 0x33_b);
+  bmp.paint_rect(bmp.bounds(), draw::gray, 0xFU);
+  EXPECT_THAT(store, ElementsAre(0xF3_b, 0xF3_b));
+}
+
+TEST(BasicBitmap, Indexed8FrameRect) {
+  auto [store, bmp] = create<draw::indexed8_bitmap>(4U, 3U);
+  bmp.frame_rect(bmp.bounds(), 7U);
+  EXPECT_THAT(store, ElementsAre(7U, 7U, 7U, 7U,  // [0]
+                                 7U, 0U, 0U, 7U,  // [1]
+                                 7U, 7U, 7U, 7U   // [2]
+                                 ));
+  EXPECT_EQ(bmp.dirty(), bmp.bounds());
+}
+
+TEST(BasicBitmap, Rgb565PaintRectClipped) {
+  auto [store, bmp] = create<draw::rgb565_bitmap>(3U, 2U);
+  bmp.paint_rect(draw::rect{.top = -1, .left = 1, .bottom = 5, .right = 9}, draw::black, 0xF800U);
+  EXPECT_THAT(store, ElementsAre(0U, 0xF800U, 0xF800U,  // [0]
+                                 0U, 0xF800U, 0xF800U   // [1]
+                                 ));
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 0, .left = 1, .bottom = 1, .right = 2}));
+}
+
+TEST(BasicBitmap, Outside) {
+  auto [store, bmp] = create<draw::indexed8_bitmap>(4U, 3U);
+  bmp.paint_rect(draw::rect{.top = 0, .left = 4, .bottom = 2, .right = 9}, draw::black, 1U);
+  bmp.line(draw::point{.x = 0, .y = 3}, draw::point{.x = 3, .y = 3}, 1U);
+  EXPECT_THAT(store, Each(0U));
+  EXPECT_FALSE(bmp.dirty().has_value());
+}
+
+}  // end anonymous namespace
@@ -0,0 +1,215 @@
+//===- unit_tests/test_box_blur.cpp ---------------------------------------===//
+//*  _                 _     _             *
+//* | |__   _____  __ | |__ | |_   _ _ __  *
+//* | '_ \ / _ \ \/ / | '_ \| | | | | '__| *
+//* | |_) | (_) >  <  | |_) | | |_| | |    *
+//* |_.__/ \___/_/\_\ |_.__/|_|\__,_|_|    *
+//*                                        *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/alpha8.hpp"
+#include "draw/bitmap32.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+
+using testing::Each;
+using testing::ElementsAre;
+using testing::ElementsAreArray;
+
+namespace {
+
+// Returns a reproducible sequence of bytes.
+std::vector<std::uint8_t> noise(std::size_t const size, std::uint32_t seed) {
+  std::vector<std::uint8_t> result(size);
+  for (auto& v : result) {
+    seed = seed * 1664525U + 1013904223U;
+    v = static_cast<std::uint8_t>(seed >> 24);
+  }
+  return result;
+}
+
+// A direct implementation of the blur: each value is the rounded mean of the 2 * radius + 1 values around it along
+// a row and then a column with indices clamped to the area. Values are separated by `channels` bytes along a row.
+void reference_blur(std::vector<std::uint8_t>& v, std::size_t const stride, draw::rect const& r,
+                    unsigned const channels, unsigned const radius, unsigned const passes) {
+  auto const d = 2 * static_cast<int>(radius) + 1;
+  auto const blur_line = [&](std::size_t const first, std::size_t const step, int const length) {
+    std::vector<std::uint8_t> line(static_cast<std::size_t>(length));
+    for (auto i = 0; i < length; ++i) {
+      line[static_cast<std::size_t>(i)] = v[first + static_cast<std::size_t>(i) * step];
+    }
+    for (auto i = 0; i < length; ++i) {
+      auto sum = 0;
+      for (auto k = i - static_cast<int>(radius); k <= i + static_cast<int>(radius); ++k) {
+        sum += line[static_cast<std::size_t>(std::clamp(k, 0, length - 1))];
+      }
+      v[first + static_cast<std::size_t>(i) * step] = static_cast<std::uint8_t>((sum + d / 2) / d);
+    }
+  };
+  auto const width = r.right - r.left + 1;
+  auto const height = r.bottom - r.top + 1;
+  for (auto pass = 0U; pass < passes; ++pass) {
+    for (auto y = r.top; y <= r.bottom; ++y) {
+      for (auto c = 0U; c < channels; ++c) {
+        blur_line(static_cast<std::size_t>(y) * stride + static_cast<std::size_t>(r.left) * channels + c, channels,
+                  width);
+      }
+    }
+    for (auto x = static_cast<std::size_t>(r.left) * channels; x < static_cast<std::size_t>(r.right + 1) * channels;
+         ++x) {
+      blur_line(static_cast<std::size_t>(r.top) * stride + x, stride, height);
+    }
+  }
+}
+
+TEST(BoxBlurAlpha8, Impulse) {
+  std::vector<std::uint8_t> store{0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00};
+  draw::alpha8 mask{store, 7U, 1U};
+  mask.box_blur(mask.bounds(), 1U, 1U);
+  EXPECT_THAT(store, ElementsAre(0x00, 0x00, 0x55, 0x55, 0x55, 0x00, 0x00));
+  EXPECT_EQ(mask.dirty(), mask.bounds());
+}
+
+TEST(BoxBlurAlpha8, UniformIsUnchanged) {
+  std::vector<std::uint8_t> store(draw::alpha8::required_store_size(9U, 5U), std::uint8_t{0xC3});
+  draw::alpha8 mask{store, 9U, 5U};
+  mask.box_blur(mask.bounds(), draw::max_blur_radius);
+  EXPECT_THAT(store, Each(std::uint8_t{0xC3}));
+}
+
+TEST(BoxBlurAlpha8, ZeroRadius) {
+  auto store = noise(draw::alpha8::required_store_size(4U, 4U), 1U);
+  auto const expected = store;
+  draw::alpha8 mask{store, 4U, 4U};
+  mask.box_blur(mask.bounds(), 0U);
+  EXPECT_EQ(store, expected);
+  EXPECT_FALSE(mask.dirty().has_value());
+}
+
+class BoxBlur : public testing::TestWithParam<std::tuple<unsigned, unsigned>> {};
+
+TEST_P(BoxBlur, Alpha8MatchesReference) {
+  auto const [radius, passes] = GetParam();
+  constexpr auto width = std::uint16_t{83};
+  constexpr auto height = std::uint16_t{21};
+  auto store = noise(draw::alpha8::required_store_size(width, height), radius);
+  auto expected = store;
+  // The area overhangs the left and bottom edges; clipping leaves the pixels outside it untouched.
+  auto const r = draw::rect{.top = 3, .left = -4, .bottom = 30, .right = 70};
+  reference_blur(expected, width, draw::rect{.top = 3, .left = 0, .bottom = height - 1, .right = 70}, 1U, radius,
+                 passes);
+  draw::alpha8 mask{store, width, height};
+  mask.box_blur(r, radius, passes);
+  EXPECT_EQ(store, expected);
+  EXPECT_EQ(mask.dirty(), (draw::rect{.top = 3, .left = 0, .bottom = height - 1, .right = 70}));
+}
+
+TEST_P(BoxBlur, Bitmap32MatchesReference) {
+  auto const [radius, passes] = GetParam();
+  constexpr auto width = std::uint16_t{29};
+  constexpr auto height = std::uint16_t{17};
+  auto [store, bmp] = create_bitmap32_and_store(width, height);
+  auto bytes = noise(store.size() * 4U, radius + 1U);
+  for (auto i = std::size_t{0}; i < store.size(); ++i) {
+    store[i] = draw::rgba_premult{bytes[i * 4U], bytes[i * 4U + 1U], bytes[i * 4U + 2U], bytes[i * 4U + 3U]};
+  }
+  auto const r = draw::rect{.top = 1, .left = 2, .bottom = 15, .right = 27};
+  reference_blur(bytes, std::size_t{width} * 4U, r, 4U, radius, passes);
+  bmp.box_blur(r, radius, passes);
+  for (auto i = std::size_t{0}; i < store.size(); ++i) {
+    EXPECT_EQ(store[i], (draw::rgba_premult{bytes[i * 4U], bytes[i * 4U + 1U], bytes[i * 4U + 2U], bytes[i * 4U + 3U]}))
+        << "i=" << i;
+  }
+  EXPECT_EQ(bmp.dirty(), r);
+}
+
+INSTANTIATE_TEST_SUITE_P(RadiiAndPasses, BoxBlur,
+                         testing::Combine(testing::Values(1U, 2U, 7U, 20U, draw::max_blur_radius),
+                                          testing::Values(1U, 3U)));
+
+TEST(DropShadow, HardShadow) {
+  // With a radius of zero the shadow is the layer's outline filled with the shadow color.
+  constexpr auto white = draw::rgba_premult{0xFF, 0xFF, 0xFF};
+  constexpr auto k = draw::rgba_premult{0x00, 0x00, 0x00};
+  constexpr auto r = draw::rgba_premult{0xFF, 0x00, 0x00};
+  auto [layer_store, layer] = create_bitmap32_and_store(2U, 2U);
+  std::ranges::fill(layer_store, r);
+  auto [store, bmp] = create_bitmap32_and_store(5U, 4U);
+  std::ranges::fill(store, white);
+  std::vector<std::uint8_t> scratch_store(draw::alpha8::required_store_size(2U, 2U));
+  draw::alpha8 scratch{scratch_store, 2U, 2U};
+  bmp.drop_shadow(layer, draw::point{.x = 1, .y = 0}, draw::point{.x = 2, .y = 1}, 0U,
+                  draw::rgba{.r = 0, .g = 0, .b = 0}, scratch);
+  EXPECT_THAT(store, ElementsAre(white, r, r, white, white,  // [0]
+                                 white, r, r, k, k,          // [1]
+                                 white, white, white, k, k,  // [2]
+                                 white, white, white, white, white));
+}
+
+TEST(DropShadow, SoftShadow) {
+  constexpr auto radius = 2U;
+  constexpr auto margin = draw::bitmap32::shadow_margin(radius);
+  constexpr auto white = draw::rgba_premult{0xFF, 0xFF, 0xFF};
+  auto [layer_store, layer] = create_bitmap32_and_store(4U, 4U);
+  std::ranges::fill(layer_store, draw::rgba_premult{0x00, 0x00, 0xFF});
+  constexpr auto size = std::uint16_t{4U + 2U * margin};
+  auto [store, bmp] = create_bitmap32_and_store(size, size);
+  std::ranges::fill(store, white);
+  std::vector<std::uint8_t> scratch_store(draw::alpha8::required_store_size(size, size));
+  draw::alpha8 scratch{scratch_store, size, size};
+  bmp.drop_shadow(layer, draw::point{.x = margin, .y = margin}, draw::point{}, radius,
+                  draw::rgba{.r = 0, .g = 0, .b = 0}, scratch);
+
+  // The layer is drawn over its shadow.
+  EXPECT_EQ(store[margin * size + margin], (draw::rgba_premult{0x00, 0x00, 0xFF}));
+  // The shadow is symmetrical about both axes, darkest next to the layer and fades away from it.
+  auto const at = [&](unsigned const x, unsigned const y) { return store[y * size + x].r; };
+  for (auto x = 0U; x < size; ++x) {
+    for (auto y = 0U; y < size; ++y) {
+      EXPECT_EQ(at(x, y), at(size - 1U - x, y));
+      EXPECT_EQ(at(x, y), at(x, size - 1U - y));
+    }
+  }
+  EXPECT_LT(at(margin - 1U, margin + 1U), at(margin - 3U, margin + 1U));
+  EXPECT_LT(at(margin - 3U, margin + 1U), 0xFF);
+  EXPECT_EQ(at(0U, 0U), 0xFF);
+  EXPECT_EQ(bmp.dirty(), bmp.bounds());
+}
+
+}  // end anonymous namespace
@@ -0,0 +1,222 @@
+//===- unit_tests/test_convert.cpp ----------------------------------------===//
+//*                                _    *
+//*   ___ ___  _ ____   _____ _ __| |_  *
+//*  / __/ _ \| '_ \ \ / / _ \ '__| __| *
+//* | (_| (_) | | | \ V /  __/ |  | |_  *
+//*  \___\___/|_| |_|\_/ \___|_|   \__| *
+//*                                     *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/convert.hpp"
+#include "draw/indexed8_bitmap.hpp"
+
+// Standard library
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+
+using testing::ElementsAre;
+using testing::ElementsAreArray;
+using namespace draw::literals;
+
+namespace {
+
+// Fills the bitmap with a reproducible sequence of valid premultiplied colors.
+void fill(draw::bitmap32& bmp, std::uint32_t seed) {
+  auto next = [&seed]() {
+    seed = seed * 1664525U + 1013904223U;
+    return static_cast<std::uint8_t>(seed >> 24);
+  };
+  for (auto& px : bmp.store()) {
+    px = draw::rgba_premult{draw::rgba{.r = next(), .g = next(), .b = next(), .a = next()}};
+  }
+}
+
+// A scalar reference implementation of each format.
+void reference(draw::rgba_premult const& px, draw::pixel_format const format, std::vector<std::byte>& out) {
+  auto const push = [&out](unsigned v) { out.push_back(static_cast<std::byte>(v)); };
+  switch (format) {
+  case draw::pixel_format::rgb565: {
+    auto const v = ((px.r & 0xF8U) << 8) | ((px.g & 0xFCU) << 3) | (px.b >> 3);
+    push(v >> 8);
+    push(v & 0xFF);
+  } break;
+  case draw::pixel_format::rgb888:
+    push(px.r);
+    push(px.g);
+    push(px.b);
+    break;
+  case draw::pixel_format::bgr888:
+    push(px.b);
+    push(px.g);
+    push(px.r);
+    break;
+  case draw::pixel_format::gray8: push((77U * px.r + 150U * px.g + 29U * px.b + 128U) >> 8); break;
+  case draw::pixel_format::rgba8888: {
+    auto const s = px.to_straight();
+    push(s.r);
+    push(s.g);
+    push(s.b);
+    push(s.a);
+  } break;
+  }
+}
+
+class Convert : public testing::TestWithParam<draw::pixel_format> {};
+
+TEST_P(Convert, MatchesReference) {
+  // An odd width ensures that the partial blocks at the end of each row are exercised.
+  auto [store, bmp] = create_bitmap32_and_store(13U, 3U);
+  fill(bmp, 1U);
+
+  std::vector<std::byte> expected;
+  for (auto const& px : store) {
+    reference(px, GetParam(), expected);
+  }
+  std::vector<std::byte> actual(expected.size());
+  auto const result = draw::convert(bmp, bmp.bounds(), GetParam(), actual);
+  EXPECT_EQ(result.data(), actual.data());
+  EXPECT_EQ(result.size(), expected.size());
+  EXPECT_THAT(actual, ElementsAreArray(expected));
+}
+
+TEST_P(Convert, AreaOnly) {
+  auto [store, bmp] = create_bitmap32_and_store(9U, 4U);
+  fill(bmp, 2U);
+  auto const area = draw::rect{.top = 1, .left = 2, .bottom = 2, .right = 7};
+
+  std::vector<std::byte> expected;
+  for (auto y = 1U; y <= 2U; ++y) {
+    for (auto x = 2U; x <= 7U; ++x) {
+      reference(store[y * bmp.stride() + x], GetParam(), expected);
+    }
+  }
+  std::vector<std::byte> actual(bmp.width() * bmp.height() * draw::bytes_per_pixel(GetParam()), 0xFF_b);
+  auto const result = draw::convert(bmp, area, GetParam(), actual);
+  EXPECT_THAT(result, ElementsAreArray(expected));
+}
+
+INSTANTIATE_TEST_SUITE_P(AllFormats, Convert,
+                         testing::Values(draw::pixel_format::rgb565, draw::pixel_format::rgb888,
+                                         draw::pixel_format::bgr888, draw::pixel_format::gray8,
+                                         draw::pixel_format::rgba8888));
+
+TEST(Convert, Rgb565ByteOrder) {
+  auto [store, bmp] = create_bitmap32_and_store(2U, 1U);
+  store[0] = draw::rgba_premult{0xFF, 0x00, 0x00};
+  store[1] = draw::rgba_premult{0x00, 0x00, 0xFF};
+  std::array<std::byte, 4> actual{};
+  draw::convert(bmp, bmp.bounds(), draw::pixel_format::rgb565, actual);
+  EXPECT_THAT(actual, ElementsAre(0xF8_b, 0x00_b, 0x00_b, 0x1F_b));
+}
+
+TEST(Convert, Clipped) {
+  auto [store, bmp] = create_bitmap32_and_store(3U, 2U);
+  std::ranges::fill(store, draw::rgba_premult{0x10, 0x20, 0x30});
+  std::array<std::byte, 18> actual{};
+  auto const area = draw::rect{.top = -5, .left = 1, .bottom = 10, .right = 20};
+  auto const result = draw::convert(bmp, area, draw::pixel_format::rgb888, actual);
+  EXPECT_THAT(result, ElementsAre(0x10_b, 0x20_b, 0x30_b, 0x10_b, 0x20_b, 0x30_b,  // [0]
+                                  0x10_b, 0x20_b, 0x30_b, 0x10_b, 0x20_b, 0x30_b   // [1]
+                                  ));
+}
+
+TEST(Convert, Outside) {
+  auto [store, bmp] = create_bitmap32_and_store(3U, 2U);
+  std::array<std::byte, 4> actual{};
+  EXPECT_TRUE(draw::convert(bmp, draw::rect{.top = 0, .left = 3, .bottom = 1, .right = 5}, draw::pixel_format::gray8,
+                            actual)
+                  .empty());
+}
+
+TEST(Convert, StraightAlphaMatchesToStraight) {
+  // Every combination of color and alpha value (including the invalid cases where the color exceeds alpha).
+  auto [store, bmp] = create_bitmap32_and_store(256U, 256U);
+  for (auto a = 0U; a < 256U; ++a) {
+    for (auto c = 0U; c < 256U; ++c) {
+      auto const v = static_cast<std::uint8_t>(c);
+      store[a * bmp.stride() + c] = draw::rgba_premult{v, v, v, static_cast<std::uint8_t>(a)};
+    }
+  }
+  std::vector<std::byte> expected;
+  for (auto const& px : store) {
+    reference(px, draw::pixel_format::rgba8888, expected);
+  }
+  std::vector<std::byte> actual(expected.size());
+  draw::convert(bmp, bmp.bounds(), draw::pixel_format::rgba8888, actual);
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(ConvertClut, MatchesBitmap32) {
+  // A palette of arbitrary colors and the equivalent bitmap32 must produce the same RGB565 output.
+  auto [store32, bmp32] = create_bitmap32_and_store(13U, 3U);
+  fill(bmp32, 3U);
+  std::array<draw::rgba_premult, 256> palette{};
+  std::array<std::uint16_t, 256> clut{};
+  std::vector<std::uint8_t> store8(draw::indexed8_bitmap::required_store_size(13U, 3U));
+  draw::indexed8_bitmap bmp8{store8, 13U, 3U};
+  for (auto index = 0U; index < store32.size(); ++index) {
+    palette[index] = store32[index];
+    clut[index] = draw::to_rgb565(palette[index]);
+    store8[index] = static_cast<std::uint8_t>(index);
+  }
+
+  std::vector<std::byte> expected(store32.size() * 2U);
+  draw::convert(bmp32, bmp32.bounds(), draw::pixel_format::rgb565, expected);
+  std::vector<std::byte> actual(expected.size());
+  auto const result = draw::convert(bmp8, bmp8.bounds(), clut, actual);
+  EXPECT_EQ(result.size(), expected.size());
+  EXPECT_THAT(actual, ElementsAreArray(expected));
+}
+
+TEST(ConvertClut, DirtyAreaOnly) {
+  std::array<std::uint16_t, 256> clut{};
+  clut[1] = 0x1234;
+  clut[2] = 0xABCD;
+  std::vector<std::uint8_t> store8(draw::indexed8_bitmap::required_store_size(6U, 4U));
+  draw::indexed8_bitmap bmp8{store8, 6U, 4U};
+  bmp8.paint_rect(draw::rect{.top = 1, .left = 2, .bottom = 2, .right = 3}, draw::black, 1U, 2U);
+  ASSERT_TRUE(bmp8.dirty().has_value());
+  std::vector<std::byte> actual(store8.size() * 2U, 0xFF_b);
+  auto const result = draw::convert(bmp8, *bmp8.dirty(), clut, actual);
+  EXPECT_THAT(result, ElementsAre(0x12_b, 0x34_b, 0x12_b, 0x34_b,  // [1]
+                                  0x12_b, 0x34_b, 0x12_b, 0x34_b   // [2]
+                                  ));
+  bmp8.paint_rect(draw::rect{.top = 3, .left = 5, .bottom = 10, .right = 10}, draw::white, 1U, 2U);
+  EXPECT_THAT(draw::convert(bmp8, draw::rect{.top = 3, .left = 5, .bottom = 3, .right = 5}, clut, actual),
+              ElementsAre(0xAB_b, 0xCD_b));
+}
+
+}  // end anonymous namespace
@@ -0,0 +1,304 @@
+//===- unit_tests/test_copy32.cpp -----------------------------------------===//
+//*                        _________   *
+//*   ___ ___  _ __  _   _|___ /___ \  *
+//*  / __/ _ \| '_ \| | | | |_ \ __) | *
+//* | (_| (_) | |_) | |_| |___) / __/  *
+//*  \___\___/| .__/ \__, |____/_____| *
+//*           |_|    |___/             *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/bitmap32.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+#include "rect.hpp"
+
+using testing::Each;
+using testing::ElementsAre;
+using testing::ElementsAreArray;
+using transfer_mode = draw::bitmap32::transfer_mode;
+
+namespace {
+
+// An exact reference implementation of each of the transfer modes with the same rounding as the library. Intermediate
+// values are unbounded; the final result is clamped to a byte.
+unsigned div255(unsigned const x) {
+  return (x + 0x80 + (x >> 8)) >> 8;
+}
+unsigned add(unsigned const a, unsigned const b) {
+  return a + b;
+}
+unsigned sub(unsigned const a, unsigned const b) {
+  return a > b ? a - b : 0U;
+}
+
+unsigned blend_channel(transfer_mode const mode, unsigned const s, unsigned const sa, unsigned const d,
+                       unsigned const da) {
+  auto const outside = add(div255(s * (0xFF - da)), div255(d * (0xFF - sa)));
+  switch (mode) {
+  case transfer_mode::mode_clear: return 0;
+  case transfer_mode::mode_src: return s;
+  case transfer_mode::mode_src_over: return add(s, div255(d * (0xFF - sa)));
+  case transfer_mode::mode_dst_over: return add(d, div255(s * (0xFF - da)));
+  case transfer_mode::mode_src_in: return div255(s * da);
+  case transfer_mode::mode_dst_out: return div255(d * (0xFF - sa));
+  case transfer_mode::mode_xor: return outside;
+  case transfer_mode::mode_multiply: return add(div255(s * d), outside);
+  case transfer_mode::mode_screen: return sub(add(s, d), div255(s * d));
+  case transfer_mode::mode_darken: return add(std::min(div255(s * da), div255(d * sa)), outside);
+  case transfer_mode::mode_lighten: return add(std::max(div255(s * da), div255(d * sa)), outside);
+  case transfer_mode::mode_src_over_linear: break;  // Compared with an ideal model by the Copy32Linear tests.
+  }
+  return 0;
+}
+
+draw::rgba_premult blend(transfer_mode const mode, draw::rgba_premult const& s, draw::rgba_premult const& d) {
+  auto const channel = [&](std::uint8_t sc, std::uint8_t dc) {
+    return static_cast<std::uint8_t>(std::min(blend_channel(mode, sc, s.a, dc, d.a), 0xFFU));
+  };
+  return {channel(s.r, d.r), channel(s.g, d.g), channel(s.b, d.b), channel(s.a, d.a)};
+}
+
+// Fills the bitmap with a reproducible sequence of valid premultiplied colors.
+void fill(draw::bitmap32& bmp, std::uint32_t seed) {
+  auto next = [&seed]() {
+    seed = seed * 1664525U + 1013904223U;
+    return static_cast<std::uint8_t>(seed >> 24);
+  };
+  for (auto& px : bmp.store()) {
+    px = draw::rgba_premult{draw::rgba{.r = next(), .g = next(), .b = next(), .a = next()}};
+  }
+}
+
+class Copy32 : public testing::TestWithParam<transfer_mode> {};
+
+TEST_P(Copy32, MatchesReference) {
+  // An odd width ensures that the partial blocks at the end of each row are exercised.
+  constexpr auto width = std::uint16_t{11};
+  constexpr auto height = std::uint16_t{3};
+  auto [src_store, src] = create_bitmap32_and_store(width, height);
+  auto [dest_store, dest] = create_bitmap32_and_store(width, height);
+  fill(src, 1U);
+  fill(dest, 2U);
+
+  std::vector<draw::rgba_premult> expected;
+  expected.reserve(dest_store.size());
+  std::ranges::transform(src_store, dest_store, std::back_inserter(expected),
+                         [mode = GetParam()](draw::rgba_premult const& s, draw::rgba_premult const& d) {
+                           return blend(mode, s, d);
+                         });
+
+  dest.copy(src, draw::point{.x = 0, .y = 0}, GetParam());
+  EXPECT_THAT(dest.store(), ElementsAreArray(expected));
+  EXPECT_EQ(dest.dirty(), (draw::rect{.top = 0, .left = 0, .bottom = height - 1, .right = width - 1}));
+}
+
+INSTANTIATE_TEST_SUITE_P(AllModes, Copy32,
+                         testing::Values(transfer_mode::mode_clear, transfer_mode::mode_src,
+                                         transfer_mode::mode_src_over, transfer_mode::mode_dst_over,
+                                         transfer_mode::mode_src_in, transfer_mode::mode_dst_out,
+                                         transfer_mode::mode_xor, transfer_mode::mode_multiply,
+                                         transfer_mode::mode_screen, transfer_mode::mode_darken,
+                                         transfer_mode::mode_lighten));
+
+TEST(Copy32, SrcOverMatchesComposite) {
+  auto [src_store, src] = create_bitmap32_and_store(7U, 2U);
+  auto [dest_store, dest] = create_bitmap32_and_store(7U, 2U);
+  fill(src, 3U);
+  fill(dest, 4U);
+  std::vector<draw::rgba_premult> expected = dest_store;
+  for (auto ctr = std::size_t{0}; ctr < expected.size(); ++ctr) {
+    expected[ctr].composite(src_store[ctr]);
+  }
+  dest.copy(src, draw::point{.x = 0, .y = 0}, transfer_mode::mode_src_over);
+  EXPECT_THAT(dest.store(), ElementsAreArray(expected));
+}
+
+TEST(Copy32, ClippedBottomRight) {
+  constexpr auto r = draw::rgba_premult{0xFF, 0x00, 0x00};
+  constexpr auto x = draw::rgba_premult{};
+  auto [src_store, src] = create_bitmap32_and_store(4U, 4U);
+  std::ranges::fill(src_store, r);
+  auto [dest_store, dest] = create_bitmap32_and_store(5U, 3U);
+  dest.copy(src, draw::point{.x = 3, .y = 1}, transfer_mode::mode_src);
+  EXPECT_THAT(dest.store(), ElementsAre(x, x, x, x, x,  // [0]
+                                        x, x, x, r, r,  // [1]
+                                        x, x, x, r, r   // [2]
+                                        ));
+  EXPECT_EQ(dest.dirty(), (draw::rect{.top = 1, .left = 3, .bottom = 2, .right = 4}));
+}
+
+TEST(Copy32, ClippedTopLeft) {
+  constexpr auto r = draw::rgba_premult{0xFF, 0x00, 0x00};
+  constexpr auto x = draw::rgba_premult{};
+  auto [src_store, src] = create_bitmap32_and_store(4U, 4U);
+  std::ranges::fill(src_store, r);
+  auto [dest_store, dest] = create_bitmap32_and_store(5U, 3U);
+  dest.copy(src, draw::point{.x = -2, .y = -3}, transfer_mode::mode_src);
+  EXPECT_THAT(dest.store(), ElementsAre(r, r, x, x, x,  // [0]
+                                        x, x, x, x, x,  // [1]
+                                        x, x, x, x, x   // [2]
+                                        ));
+  EXPECT_EQ(dest.dirty(), (draw::rect{.top = 0, .left = 0, .bottom = 0, .right = 1}));
+}
+
+TEST(Copy32, Outside) {
+  auto [src_store, src] = create_bitmap32_and_store(4U, 4U);
+  std::ranges::fill(src_store, draw::rgba_premult{0xFF, 0x00, 0x00});
+  auto [dest_store, dest] = create_bitmap32_and_store(5U, 3U);
+  dest.copy(src, draw::point{.x = 5, .y = 0}, transfer_mode::mode_src);
+  dest.copy(src, draw::point{.x = -4, .y = 0}, transfer_mode::mode_src);
+  EXPECT_THAT(dest.store(), Each(draw::rgba_premult{}));
+  EXPECT_FALSE(dest.dirty().has_value());
+}
+
+// An ideal model of source-over in linear light using floating point and pow().
+draw::rgba_premult over_linear(draw::rgba_premult const& s, draw::rgba_premult const& d) {
+  auto const decode = [](double v) { return v <= 0.04045 ? v / 12.92 : std::pow((v + 0.055) / 1.055, 2.4); };
+  auto const encode = [](double v) { return v <= 0.0031308 ? v * 12.92 : 1.055 * std::pow(v, 1.0 / 2.4) - 0.055; };
+  auto const sa = s.a / 255.0;
+  auto const da = d.a / 255.0;
+  auto const out_a = sa + da * (1.0 - sa);
+  auto const channel = [&](std::uint8_t const sc, std::uint8_t const dc) {
+    auto const ls = sa == 0.0 ? 0.0 : decode(std::min(sc / 255.0 / sa, 1.0));
+    auto const ld = da == 0.0 ? 0.0 : decode(std::min(dc / 255.0 / da, 1.0));
+    auto const p = out_a == 0.0 ? 0.0 : (ls * sa + ld * da * (1.0 - sa)) / out_a;
+    return static_cast<std::uint8_t>(std::lround(encode(p) * out_a * 255.0));
+  };
+  return {channel(s.r, d.r), channel(s.g, d.g), channel(s.b, d.b), static_cast<std::uint8_t>(std::lround(out_a * 255))};
+}
+
+class Copy32Linear : public testing::TestWithParam<bool> {};
+
+TEST_P(Copy32Linear, MatchesIdeal) {
+  bool const opaque_dest = GetParam();
+  auto [src_store, src] = create_bitmap32_and_store(11U, 7U);
+  auto [dest_store, dest] = create_bitmap32_and_store(11U, 7U);
+  fill(src, 5U);
+  fill(dest, 6U);
+  if (opaque_dest) {
+    std::ranges::for_each(dest_store, [](draw::rgba_premult& px) { px.a = 0xFF; });
+  }
+  auto const original = dest_store;
+  dest.copy(src, draw::point{.x = 0, .y = 0}, transfer_mode::mode_src_over_linear);
+  for (auto index = std::size_t{0}; index < dest_store.size(); ++index) {
+    auto const expected = over_linear(src_store[index], original[index]);
+    auto const& actual = dest_store[index];
+    // Quantization to 8 bits and to the 4096-entry table allows a small error: larger in the darkest tones of
+    // translucent results where unpremultiplying magnifies it.
+    auto const tolerance = opaque_dest ? 1 : 3;
+    EXPECT_NEAR(actual.r, expected.r, tolerance) << "index " << index;
+    EXPECT_NEAR(actual.g, expected.g, tolerance) << "index " << index;
+    EXPECT_NEAR(actual.b, expected.b, tolerance) << "index " << index;
+    EXPECT_NEAR(actual.a, expected.a, 1) << "index " << index;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(OpaqueAndTranslucent, Copy32Linear, testing::Bool());
+
+TEST(Copy32Linear, HalfWhiteOverBlack) {
+  auto [src_store, src] = create_bitmap32_and_store(5U, 1U);
+  auto [dest_store, dest] = create_bitmap32_and_store(5U, 1U);
+  std::ranges::fill(src_store, draw::rgba_premult{draw::rgba{.r = 0xFF, .g = 0xFF, .b = 0xFF, .a = 0x80}});
+  dest.copy(src, draw::point{.x = 0, .y = 0}, transfer_mode::mode_src_over_linear);
+  // Half intensity in linear light is about 73% in sRGB where the sRGB blend gives 50%.
+  EXPECT_THAT(dest_store, Each(draw::rgba_premult{0xBC, 0xBC, 0xBC}));
+}
+
+TEST(Copy32Linear, OpaqueAndTransparentSourcesAreExact) {
+  auto [src_store, src] = create_bitmap32_and_store(6U, 1U);
+  auto [dest_store, dest] = create_bitmap32_and_store(6U, 1U);
+  fill(dest, 7U);
+  std::ranges::for_each(dest_store, [](draw::rgba_premult& px) { px.a = 0xFF; });
+  auto const original = dest_store;
+  std::ranges::copy(std::array{draw::rgba_premult{0x01, 0x02, 0x03}, draw::rgba_premult{0, 0, 0, 0},
+                               draw::rgba_premult{0x80, 0x40, 0x20, 0x80}, draw::rgba_premult{0xFE, 0x10, 0x00},
+                               draw::rgba_premult{0, 0, 0, 0}, draw::rgba_premult{0x05, 0x06, 0x07}},
+                    src_store.begin());
+  dest.copy(src, draw::point{.x = 0, .y = 0}, transfer_mode::mode_src_over_linear);
+  EXPECT_EQ(dest_store[0], src_store[0]);
+  EXPECT_EQ(dest_store[1], original[1]);
+  EXPECT_EQ(dest_store[3], src_store[3]);
+  EXPECT_EQ(dest_store[4], original[4]);
+  EXPECT_EQ(dest_store[5], src_store[5]);
+}
+
+TEST(Copy32Keyed, MatchesReference) {
+  constexpr auto magenta = draw::rgba{.r = 0xFF, .g = 0x00, .b = 0xFF};
+  // An odd width ensures that the partial blocks at the end of each row are exercised.
+  constexpr auto width = std::uint16_t{11};
+  constexpr auto height = std::uint16_t{3};
+  auto [src_store, src] = create_bitmap32_and_store(width, height);
+  auto [dest_store, dest] = create_bitmap32_and_store(width, height);
+  fill(src, 3U);
+  fill(dest, 4U);
+  // Key roughly every third pixel. A pixel that differs from the key in alpha alone is not keyed.
+  for (auto index = std::size_t{0}; index < src_store.size(); index += 3U) {
+    src_store[index] = draw::rgba_premult{magenta};
+  }
+  src_store[1] = draw::rgba_premult{0xFF, 0x00, 0xFF, 0xFE};
+  auto expected = dest_store;
+  for (auto index = std::size_t{0}; index < src_store.size(); ++index) {
+    if (src_store[index] != draw::rgba_premult{magenta}) {
+      expected[index] = src_store[index];
+    }
+  }
+  dest.copy_keyed(src, draw::point{.x = 0, .y = 0}, magenta);
+  EXPECT_THAT(dest_store, ElementsAreArray(expected));
+  EXPECT_EQ(dest.dirty(), dest.bounds());
+}
+
+TEST(Copy32Keyed, Clipped) {
+  constexpr auto key = draw::rgba{.r = 0x00, .g = 0xFF, .b = 0x00};
+  constexpr auto k = draw::rgba_premult{key};
+  constexpr auto a = draw::rgba_premult{0x11, 0x22, 0x33};
+  constexpr auto b = draw::rgba_premult{0x44, 0x55, 0x66};
+  constexpr auto x = draw::rgba_premult{};
+  auto [src_store, src] = create_bitmap32_and_store(3U, 2U);
+  std::ranges::copy(std::array{a, k, b,   // [0]
+                               k, b, a},  // [1]
+                    src_store.begin());
+  auto [dest_store, dest] = create_bitmap32_and_store(3U, 3U);
+  dest.copy_keyed(src, draw::point{.x = -1, .y = 1}, key);
+  EXPECT_THAT(dest_store, ElementsAre(x, x, x,    // [0]
+                                      x, b, x,    // [1]
+                                      b, a, x));  // [2]
+  EXPECT_EQ(dest.dirty(), (draw::rect{.top = 1, .left = 0, .bottom = 2, .right = 1}));
+}
+
+}  // end anonymous namespace
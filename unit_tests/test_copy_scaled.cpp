@@ -0,0 +1,187 @@
+//===- unit_tests/test_copy_scaled.cpp ------------------------------------===//
+//*                                        _          _  *
+//*   ___ ___  _ __  _   _   ___  ___ __ _| | ___  __| | *
+//*  / __/ _ \| '_ \| | | | / __|/ __/ _` | |/ _ \/ _` | *
+//* | (_| (_) | |_) | |_| | \__ \ (_| (_| | |  __/ (_| | *
+//*  \___\___/| .__/ \__, | |___/\___\__,_|_|\___|\__,_| *
+//*           |_|    |___/                               *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/bitmap32.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+
+using testing::Each;
+using testing::ElementsAre;
+using testing::ElementsAreArray;
+using scale_filter = draw::bitmap32::scale_filter;
+
+namespace {
+
+// Fills the bitmap with a reproducible sequence of valid premultiplied colors.
+void fill(draw::bitmap32& bmp, std::uint32_t seed) {
+  auto next = [&seed]() {
+    seed = seed * 1664525U + 1013904223U;
+    return static_cast<std::uint8_t>(seed >> 24);
+  };
+  for (auto& px : bmp.store()) {
+    px = draw::rgba_premult{draw::rgba{.r = next(), .g = next(), .b = next(), .a = next()}};
+  }
+}
+
+constexpr draw::rgba_premult gray(std::uint8_t const v) {
+  return draw::rgba_premult{v, v, v, 0xFF};
+}
+
+class CopyScaled : public testing::TestWithParam<scale_filter> {};
+
+TEST_P(CopyScaled, IdentityIsACopy) {
+  auto [src_store, src] = create_bitmap32_and_store(5U, 3U);
+  auto [dest_store, dest] = create_bitmap32_and_store(5U, 3U);
+  fill(src, 1U);
+  dest.copy_scaled(src, draw::rect{.top = 0, .left = 0, .bottom = 2, .right = 4}, GetParam());
+  EXPECT_THAT(dest_store, ElementsAreArray(src_store));
+  EXPECT_EQ(dest.dirty(), dest.bounds());
+}
+
+TEST_P(CopyScaled, UniformColorIsPreserved) {
+  auto const c = draw::rgba_premult{draw::rgba{.r = 0x12, .g = 0x9A, .b = 0xE7, .a = 0x80}};
+  auto [src_store, src] = create_bitmap32_and_store(3U, 3U);
+  std::ranges::fill(src_store, c);
+  auto [dest_store, dest] = create_bitmap32_and_store(7U, 5U);
+  dest.copy_scaled(src, dest.bounds(), GetParam());
+  EXPECT_THAT(dest_store, Each(c));
+}
+
+TEST_P(CopyScaled, ClippedMatchesUnclipped) {
+  // The destination is wider than one of the library's column strips and the scaled image overhangs every edge.
+  constexpr auto width = std::uint16_t{80};
+  constexpr auto height = std::uint16_t{12};
+  constexpr auto margin = 10;
+  auto [src_store, src] = create_bitmap32_and_store(7U, 5U);
+  fill(src, 2U);
+
+  auto [dest_store, dest] = create_bitmap32_and_store(width, height);
+  dest.copy_scaled(src, draw::rect{.top = -3, .left = -5, .bottom = 14, .right = 90}, GetParam());
+  EXPECT_EQ(dest.dirty(), dest.bounds());
+
+  auto [ref_store, ref] = create_bitmap32_and_store(width + 2 * margin, height + 2 * margin);
+  ref.copy_scaled(src, draw::rect{.top = -3 + margin, .left = -5 + margin, .bottom = 14 + margin, .right = 90 + margin},
+                  GetParam());
+  for (auto y = 0U; y < height; ++y) {
+    for (auto x = 0U; x < width; ++x) {
+      EXPECT_EQ(dest_store[y * width + x], ref_store[(y + margin) * ref.stride() + x + margin])
+          << "x=" << x << " y=" << y;
+    }
+  }
+}
+
+TEST_P(CopyScaled, EntirelyOutside) {
+  auto [src_store, src] = create_bitmap32_and_store(2U, 2U);
+  fill(src, 3U);
+  auto [dest_store, dest] = create_bitmap32_and_store(4U, 4U);
+  dest.copy_scaled(src, draw::rect{.top = 0, .left = 4, .bottom = 3, .right = 7}, GetParam());
+  dest.copy_scaled(src, draw::rect{.top = -4, .left = 0, .bottom = -1, .right = 3}, GetParam());
+  EXPECT_THAT(dest_store, Each(draw::rgba_premult{}));
+  EXPECT_FALSE(dest.dirty().has_value());
+}
+
+TEST_P(CopyScaled, TransferMode) {
+  auto const half_red = draw::rgba_premult{draw::rgba{.r = 0xFF, .g = 0x00, .b = 0x00, .a = 0x80}};
+  auto [src_store, src] = create_bitmap32_and_store(1U, 1U);
+  src_store[0] = half_red;
+  auto [dest_store, dest] = create_bitmap32_and_store(3U, 2U);
+  std::ranges::fill(dest_store, gray(0xFF));
+  dest.copy_scaled(src, dest.bounds(), GetParam(), draw::bitmap32::transfer_mode::mode_src_over);
+  auto expected = gray(0xFF);
+  expected.composite(half_red);
+  EXPECT_THAT(dest_store, Each(expected));
+}
+
+INSTANTIATE_TEST_SUITE_P(Filters, CopyScaled, testing::Values(scale_filter::nearest, scale_filter::bilinear));
+
+TEST(CopyScaledNearest, Enlarge) {
+  auto const a = gray(0x10);
+  auto const b = gray(0x20);
+  auto const c = gray(0x30);
+  auto const d = gray(0x40);
+  auto [src_store, src] = create_bitmap32_and_store(2U, 2U);
+  std::ranges::copy(std::array{a, b, c, d}, src_store.begin());
+  auto [dest_store, dest] = create_bitmap32_and_store(4U, 3U);
+  dest.copy_scaled(src, draw::rect{.top = 0, .left = 0, .bottom = 2, .right = 3}, scale_filter::nearest);
+  EXPECT_THAT(dest_store, ElementsAre(a, a, b, b,    // [0]
+                                      a, a, b, b,    // [1]
+                                      c, c, d, d));  // [2]
+}
+
+TEST(CopyScaledNearest, Reduce) {
+  auto [src_store, src] = create_bitmap32_and_store(6U, 1U);
+  std::ranges::copy(std::array{gray(0), gray(1), gray(2), gray(3), gray(4), gray(5)}, src_store.begin());
+  auto [dest_store, dest] = create_bitmap32_and_store(3U, 1U);
+  dest.copy_scaled(src, dest.bounds(), scale_filter::nearest);
+  EXPECT_THAT(dest_store, ElementsAre(gray(1), gray(3), gray(5)));
+}
+
+TEST(CopyScaledBilinear, Enlarge) {
+  auto [src_store, src] = create_bitmap32_and_store(2U, 1U);
+  std::ranges::copy(std::array{gray(0x00), gray(0xFF)}, src_store.begin());
+  auto [dest_store, dest] = create_bitmap32_and_store(4U, 1U);
+  dest.copy_scaled(src, dest.bounds(), scale_filter::bilinear);
+  // The outer pixels are clamped to the edges of the source; the inner pixels lie 1/4 and 3/4 of the way between
+  // the source pixels' centers.
+  EXPECT_THAT(dest_store, ElementsAre(gray(0x00), gray(0x40), gray(0xBF), gray(0xFF)));
+}
+
+TEST(CopyScaledBilinear, EnlargeVertically) {
+  auto [src_store, src] = create_bitmap32_and_store(1U, 2U);
+  std::ranges::copy(std::array{gray(0x00), gray(0xFF)}, src_store.begin());
+  auto [dest_store, dest] = create_bitmap32_and_store(1U, 4U);
+  dest.copy_scaled(src, dest.bounds(), scale_filter::bilinear);
+  EXPECT_THAT(dest_store, ElementsAre(gray(0x00), gray(0x40), gray(0xBF), gray(0xFF)));
+}
+
+TEST(CopyScaledBilinear, Reduce) {
+  auto [src_store, src] = create_bitmap32_and_store(4U, 1U);
+  std::ranges::copy(std::array{gray(0x00), gray(0x20), gray(0x80), gray(0xFF)}, src_store.begin());
+  auto [dest_store, dest] = create_bitmap32_and_store(2U, 1U);
+  dest.copy_scaled(src, dest.bounds(), scale_filter::bilinear);
+  // Each destination pixel is centered midway between a pair of source pixels.
+  EXPECT_THAT(dest_store, ElementsAre(gray(0x10), gray(0xC0)));
+}
+
+}  // end anonymous namespace
@@ -0,0 +1,228 @@
+//===- unit_tests/test_dither.cpp -----------------------------------------===//
+//*      _ _ _   _                *
+//*   __| (_) |_| |__   ___ _ __  *
+//*  / _` | | __| '_ \ / _ \ '__| *
+//* | (_| | | |_| | | |  __/ |    *
+//*  \__,_|_|\__|_| |_|\___|_|    *
+//*                               *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/bitmap.hpp"
+#include "draw/bitmap32.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+
+using testing::Each;
+using testing::ElementsAre;
+using namespace draw::literals;
+using dither_mode = draw::bitmap::dither_mode;
+
+namespace {
+
+// Fills the bitmap with a reproducible sequence of valid premultiplied colors.
+void fill(draw::bitmap32& bmp, std::uint32_t seed) {
+  auto next = [&seed]() {
+    seed = seed * 1664525U + 1013904223U;
+    return static_cast<std::uint8_t>(seed >> 24);
+  };
+  for (auto& px : bmp.store()) {
+    px = draw::rgba_premult{draw::rgba{.r = next(), .g = next(), .b = next(), .a = next()}};
+  }
+}
+
+int gray(draw::rgba_premult const& px) {
+  return static_cast<int>((77U * px.r + 150U * px.g + 29U * px.b + 0x80U) >> 8) + 0xFF - px.a;
+}
+
+bool get(draw::bitmap const& bmp, unsigned x, unsigned y) {
+  return (bmp.store()[y * bmp.stride() + x / 8U] & (0x80_b >> (x % 8U))) != 0_b;
+}
+
+// A reference implementation of the error diffusion methods using a complete matrix of errors.
+std::vector<bool> reference_diffuse(draw::bitmap32 const& src, draw::rect const& r, dither_mode mode) {
+  auto const width = static_cast<std::size_t>(r.right - r.left + 1);
+  auto const height = static_cast<std::size_t>(r.bottom - r.top + 1);
+  std::vector<std::vector<int>> errors(height + 2U, std::vector<int>(width + 2U, 0));
+  std::vector<bool> result;
+  for (auto y = std::size_t{0}; y < height; ++y) {
+    for (auto x = std::size_t{0}; x < width; ++x) {
+      auto const& px = src.store()[(y + static_cast<std::size_t>(r.top)) * src.stride() + x +
+                                   static_cast<std::size_t>(r.left)];
+      auto const value = gray(px) + errors[y][x];
+      auto const set = value < 0x80;
+      auto const err = value - (set ? 0 : 0xFF);
+      result.push_back(set);
+      auto const spread = [&](std::size_t ey, std::ptrdiff_t dx, int amount) {
+        auto const ex = static_cast<std::ptrdiff_t>(x) + dx;
+        if (ex >= 0 && ex < static_cast<std::ptrdiff_t>(width)) {
+          errors[ey][static_cast<std::size_t>(ex)] += amount;
+        }
+      };
+      if (mode == dither_mode::floyd_steinberg) {
+        spread(y, 1, err * 7 / 16);
+        spread(y + 1U, -1, err * 3 / 16);
+        spread(y + 1U, 0, err * 5 / 16);
+        spread(y + 1U, 1, err / 16);
+      } else {
+        auto const e = err / 8;
+        spread(y, 1, e);
+        spread(y, 2, e);
+        spread(y + 1U, -1, e);
+        spread(y + 1U, 0, e);
+        spread(y + 1U, 1, e);
+        spread(y + 2U, 0, e);
+      }
+    }
+  }
+  return result;
+}
+
+class Dither : public testing::TestWithParam<dither_mode> {};
+
+TEST_P(Dither, OpaqueBlack) {
+  auto [store32, src] = create_bitmap32_and_store(19U, 3U);
+  std::ranges::fill(store32, draw::rgba_premult{0x00, 0x00, 0x00});
+  auto [store, dest] = create_bitmap_and_store(19U, 3U);
+  std::array<std::int16_t, draw::bitmap::dither_errors_size(19U)> errors{};
+  dest.dither(src, src.bounds(), GetParam(), errors);
+  EXPECT_THAT(store, ElementsAre(0xFF_b, 0xFF_b, 0xE0_b,  // [0]
+                                 0xFF_b, 0xFF_b, 0xE0_b,  // [1]
+                                 0xFF_b, 0xFF_b, 0xE0_b   // [2]
+                                 ));
+  EXPECT_EQ(dest.dirty(), src.bounds());
+}
+
+TEST_P(Dither, TransparentIsClear) {
+  auto [store32, src] = create_bitmap32_and_store(16U, 2U);
+  std::ranges::fill(store32, draw::rgba_premult{0x00, 0x00, 0x00, 0x00});
+  auto [store, dest] = create_bitmap_and_store(16U, 2U);
+  std::ranges::fill(store, 0xFF_b);
+  std::array<std::int16_t, draw::bitmap::dither_errors_size(16U)> errors{};
+  dest.dither(src, src.bounds(), GetParam(), errors);
+  EXPECT_THAT(store, Each(0x00_b));
+}
+
+TEST_P(Dither, OutsideAreaUnchanged) {
+  auto [store32, src] = create_bitmap32_and_store(24U, 4U);
+  std::ranges::fill(store32, draw::rgba_premult{0x00, 0x00, 0x00});
+  auto [store, dest] = create_bitmap_and_store(24U, 4U);
+  std::array<std::int16_t, draw::bitmap::dither_errors_size(24U)> errors{};
+  auto const r = draw::rect{.top = 1, .left = 3, .bottom = 2, .right = 18};
+  dest.dither(src, r, GetParam(), errors);
+  EXPECT_THAT(store, ElementsAre(0x00_b, 0x00_b, 0x00_b,  // [0]
+                                 0x1F_b, 0xFF_b, 0xE0_b,  // [1]
+                                 0x1F_b, 0xFF_b, 0xE0_b,  // [2]
+                                 0x00_b, 0x00_b, 0x00_b   // [3]
+                                 ));
+  EXPECT_EQ(dest.dirty(), r);
+}
+
+TEST_P(Dither, Clipped) {
+  auto [store32, src] = create_bitmap32_and_store(12U, 2U);
+  std::ranges::fill(store32, draw::rgba_premult{0x00, 0x00, 0x00});
+  auto [store, dest] = create_bitmap_and_store(10U, 3U);
+  std::array<std::int16_t, draw::bitmap::dither_errors_size(10U)> errors{};
+  dest.dither(src, draw::rect{.top = -1, .left = -3, .bottom = 5, .right = 20}, GetParam(), errors);
+  EXPECT_THAT(store, ElementsAre(0xFF_b, 0xC0_b,  // [0]
+                                 0xFF_b, 0xC0_b,  // [1]
+                                 0x00_b, 0x00_b   // [2]
+                                 ));
+  EXPECT_EQ(dest.dirty(), (draw::rect{.top = 0, .left = 0, .bottom = 1, .right = 9}));
+}
+
+INSTANTIATE_TEST_SUITE_P(AllModes, Dither,
+                         testing::Values(dither_mode::bayer4, dither_mode::bayer8, dither_mode::floyd_steinberg,
+                                         dither_mode::atkinson));
+
+TEST(Dither, Bayer4MidGray) {
+  // Mid-gray sets exactly half of the pixels in each 4x4 tile.
+  auto [store32, src] = create_bitmap32_and_store(8U, 4U);
+  std::ranges::fill(store32, draw::rgba_premult{0x80, 0x80, 0x80});
+  auto [store, dest] = create_bitmap_and_store(8U, 4U);
+  dest.dither(src, src.bounds(), dither_mode::bayer4);
+  EXPECT_THAT(store, ElementsAre(0b0101'0101_b, 0b1010'1010_b, 0b0101'0101_b, 0b1010'1010_b));
+}
+
+TEST(Dither, Bayer8MatchesThresholds) {
+  constexpr std::array<std::array<unsigned, 8>, 8> bayer{{
+      {0, 32, 8, 40, 2, 34, 10, 42},
+      {48, 16, 56, 24, 50, 18, 58, 26},
+      {12, 44, 4, 36, 14, 46, 6, 38},
+      {60, 28, 52, 20, 62, 30, 54, 22},
+      {3, 35, 11, 43, 1, 33, 9, 41},
+      {51, 19, 59, 27, 49, 17, 57, 25},
+      {15, 47, 7, 39, 13, 45, 5, 37},
+      {63, 31, 55, 23, 61, 29, 53, 21},
+  }};
+  auto [store32, src] = create_bitmap32_and_store(21U, 11U);
+  fill(src, 1U);
+  auto [store, dest] = create_bitmap_and_store(21U, 11U);
+  auto const r = draw::rect{.top = 1, .left = 2, .bottom = 9, .right = 19};
+  dest.dither(src, r, dither_mode::bayer8);
+  for (auto y = 0U; y < dest.height(); ++y) {
+    for (auto x = 0U; x < dest.width(); ++x) {
+      auto const inside = y >= 1U && y <= 9U && x >= 2U && x <= 19U;
+      auto const threshold = static_cast<int>((bayer[y % 8U][x % 8U] * 2U + 1U) * 2U);
+      EXPECT_EQ(get(dest, x, y), inside && gray(store32[y * src.stride() + x]) < threshold) << "x=" << x << " y=" << y;
+    }
+  }
+}
+
+class DitherDiffuse : public testing::TestWithParam<dither_mode> {};
+
+TEST_P(DitherDiffuse, MatchesReference) {
+  auto [store32, src] = create_bitmap32_and_store(23U, 9U);
+  fill(src, 2U);
+  auto [store, dest] = create_bitmap_and_store(23U, 9U);
+  auto const r = draw::rect{.top = 1, .left = 3, .bottom = 8, .right = 21};
+  std::array<std::int16_t, draw::bitmap::dither_errors_size(19U)> errors{};
+  dest.dither(src, r, GetParam(), errors);
+
+  auto const expected = reference_diffuse(src, r, GetParam());
+  auto index = std::size_t{0};
+  for (auto y = 1U; y <= 8U; ++y) {
+    for (auto x = 3U; x <= 21U; ++x) {
+      EXPECT_EQ(get(dest, x, y), expected[index++]) << "x=" << x << " y=" << y;
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(ErrorDiffusion, DitherDiffuse,
+                         testing::Values(dither_mode::floyd_steinberg, dither_mode::atkinson));
+
+}  // end anonymous namespace
@@ -69,7 +69,7 @@ TEST(DrawChar, Basic) {
       .spacing = 1,
       .glyphs = draw::font::glyph_map{
           {character, draw::glyph{decltype(draw::glyph::kerns)::from_array(draw::empty_kern),
-                                  decltype(draw::glyph::bm)::from_array(bitmap_0020)}},
+                                  decltype(draw::glyph::bm)::from_array(bitmap_0020), 2U}},
       }};
   auto [store, bmp] = create_bitmap_and_store(8U, 16U);
   std::vector glyph_cache_store{draw::glyph_cache::get_size(minimal), std::byte{0U}};
@@ -96,6 +96,49 @@ TEST(DrawChar, Basic) {
   EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 0, .left = 0, .bottom = 15, .right = 1}));
 }
 
+TEST(DrawChar, RowMajor) {
+  using namespace draw::literals;
+
+  static constexpr std::array bitmap_0020 = {
+      0b10000000_b, 0b01000000_b, 0b10000000_b, 0b01000000_b,  // rows 0-3
+      0b10000000_b, 0b01000000_b, 0b10000000_b, 0b01000000_b,  // rows 4-7
+      0b01000000_b, 0b10000000_b, 0b01000000_b, 0b10000000_b,  // rows 8-11
+      0b01000000_b, 0b10000000_b, 0b01000000_b, 0b10000000_b,  // rows 12-15
+  };
+  constexpr auto character = char32_t{0x20};
+  constexpr draw::font const minimal{
+      .id = 0xFF,
+      .baseline = 12,
+      .widest = 2,
+      .height = 2,
+      .spacing = 1,
+      .layout = draw::glyph_layout::row_major,
+      .glyphs = draw::font::glyph_map{
+          {character, draw::glyph{.kerns = decltype(draw::glyph::kerns)::from_array(draw::empty_kern),
+                                  .bm = decltype(draw::glyph::bm)::from_array(bitmap_0020),
+                                  .width = 2}},
+      }};
+  EXPECT_EQ(draw::bitmap::char_width(minimal, character), 2);
+
+  // A glyph_view draws directly from the font data.
+  draw::glyph_view gv;
+  auto const& glyph = gv.get(minimal, character);
+  EXPECT_EQ(glyph.store().data(), bitmap_0020.data());
+  EXPECT_EQ(glyph.width(), 2U);
+  EXPECT_EQ(glyph.height(), 16U);
+
+  auto [store, bmp] = create_bitmap_and_store(8U, 16U);
+  bmp.draw_char(gv, minimal, character, draw::point{.x = 0, .y = 0});
+  EXPECT_THAT(bmp.store(), testing::ElementsAreArray(bitmap_0020));
+
+  // The glyph cache gives the same result.
+  auto [store2, bmp2] = create_bitmap_and_store(8U, 16U);
+  std::vector glyph_cache_store{draw::glyph_cache::get_size(minimal), std::byte{0U}};
+  draw::glyph_cache gc{minimal, glyph_cache_store};
+  bmp2.draw_char(gc, minimal, character, draw::point{.x = 0, .y = 0});
+  EXPECT_EQ(store2, store);
+}
+
 TEST(DrawChar, A) {
   using namespace draw::literals;
 
@@ -0,0 +1,119 @@
+//===- unit_tests/test_draw_char32.cpp ------------------------------------===//
+//*      _                           _               _________   *
+//*   __| |_ __ __ ___      __   ___| |__   __ _ _ _|___ /___ \  *
+//*  / _` | '__/ _` \ \ /\ / /  / __| '_ \ / _` | '__||_ \ __) | *
+//* | (_| | | | (_| |\ V  V /  | (__| | | | (_| | |  ___) / __/  *
+//*  \__,_|_|  \__,_| \_/\_/    \___|_| |_|\__,_|_| |____/_____| *
+//*                                                              *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/all_fonts.hpp"
+#include "draw/bitmap.hpp"
+#include "draw/bitmap32.hpp"
+#include "draw/glyph_cache.hpp"
+#include "draw/sans16.hpp"
+#include "draw/types.hpp"
+
+// Standard library
+#include <string_view>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+
+constexpr auto red = draw::rgba{.r = 0xFF, .g = 0x00, .b = 0x00};
+
+/// Checks that every pixel of \p bmp32 that is set in the 1bpp bitmap \p bmp1 has been composited with \p color over
+/// \p background and that every other pixel is unchanged.
+void expect_matches(draw::bitmap const& bmp1, draw::bitmap32 const& bmp32, draw::rgba_premult const& background,
+                    draw::rgba const& color) {
+  ASSERT_EQ(bmp1.width(), bmp32.width());
+  ASSERT_EQ(bmp1.height(), bmp32.height());
+  auto painted = background;
+  painted.composite(draw::rgba_premult{color});
+  for (auto y = 0U; y < bmp1.height(); ++y) {
+    for (auto x = 0U; x < bmp1.width(); ++x) {
+      auto const bit = bmp1.store()[y * bmp1.stride() + x / 8U] & (std::byte{0x80} >> (x % 8U));
+      EXPECT_EQ(bmp32.store()[y * bmp32.stride() + x], bit != std::byte{0} ? painted : background)
+          << "x=" << x << " y=" << y;
+    }
+  }
+  EXPECT_EQ(bmp1.dirty(), bmp32.dirty());
+}
+
+class DrawChar32 : public testing::Test {
+protected:
+  std::vector<std::byte> glyph_cache_store_ =
+      std::vector(draw::glyph_cache::get_size(draw::all_fonts), std::byte{0U});
+  draw::glyph_cache gc_{draw::all_fonts, glyph_cache_store_};
+};
+
+TEST_F(DrawChar32, A) {
+  auto [store1, bmp1] = create_bitmap_and_store(16U, 16U);
+  auto [store32, bmp32] = create_bitmap32_and_store(16U, 16U);
+  bmp1.draw_char(gc_, draw::sans16, U'A', draw::point{.x = 0, .y = 0});
+  bmp32.draw_char(gc_, draw::sans16, U'A', draw::point{.x = 0, .y = 0}, red);
+  expect_matches(bmp1, bmp32, draw::rgba_premult{}, red);
+  EXPECT_EQ(bmp32.dirty(), (draw::rect{.top = 0, .left = 0, .bottom = 15, .right = 10}));
+}
+
+TEST_F(DrawChar32, Misaligned) {
+  auto [store1, bmp1] = create_bitmap_and_store(24U, 16U);
+  auto [store32, bmp32] = create_bitmap32_and_store(24U, 16U);
+  bmp1.draw_char(gc_, draw::sans16, U'W', draw::point{.x = 3, .y = 1});
+  bmp32.draw_char(gc_, draw::sans16, U'W', draw::point{.x = 3, .y = 1}, red);
+  expect_matches(bmp1, bmp32, draw::rgba_premult{}, red);
+}
+
+TEST_F(DrawChar32, ClippedTopLeft) {
+  auto [store1, bmp1] = create_bitmap_and_store(16U, 16U);
+  auto [store32, bmp32] = create_bitmap32_and_store(16U, 16U);
+  bmp1.draw_char(gc_, draw::sans16, U'M', draw::point{.x = -5, .y = -4});
+  bmp32.draw_char(gc_, draw::sans16, U'M', draw::point{.x = -5, .y = -4}, red);
+  expect_matches(bmp1, bmp32, draw::rgba_premult{}, red);
+}
+
+TEST_F(DrawChar32, TranslucentString) {
+  constexpr auto background = draw::rgba_premult{0x10, 0x20, 0x30};
+  constexpr auto green50 = draw::rgba{.r = 0x00, .g = 0xFF, .b = 0x00, .a = 0x7F};
+  auto [store1, bmp1] = create_bitmap_and_store(64U, 32U);
+  auto [store32, bmp32] = create_bitmap32_and_store(64U, 32U);
+  std::ranges::fill(store32, background);
+  auto const p1 = bmp1.draw_string(gc_, draw::sans32, u8"a1"sv, draw::point{.x = 2, .y = 0});
+  auto const p32 = bmp32.draw_string(gc_, draw::sans32, u8"a1"sv, draw::point{.x = 2, .y = 0}, green50);
+  EXPECT_EQ(p1, p32);
+  expect_matches(bmp1, bmp32, background, green50);
+}
+
+}  // end anonymous namespace
@@ -0,0 +1,145 @@
+//===- unit_tests/test_expand.cpp -----------------------------------------===//
+//*                                  _  *
+//*   _____  ___ __   __ _ _ __   __| | *
+//*  / _ \ \/ / '_ \ / _` | '_ \ / _` | *
+//* |  __/>  <| |_) | (_| | | | | (_| | *
+//*  \___/_/\_\ .__/ \__,_|_| |_|\__,_| *
+//*           |_|                       *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/bitmap.hpp"
+#include "draw/bitmap32.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+
+using testing::ElementsAre;
+using namespace draw::literals;
+
+namespace {
+
+constexpr auto red = draw::rgba{.r = 0xFF, .g = 0x00, .b = 0x00};
+constexpr auto blue = draw::rgba{.r = 0x00, .g = 0x00, .b = 0xFF};
+constexpr auto r = draw::rgba_premult{red};
+constexpr auto b = draw::rgba_premult{blue};
+constexpr auto x = draw::rgba_premult{};
+
+TEST(Expand, ForegroundAndBackground) {
+  auto [store, mono] = create_bitmap_and_store(10U, 2U);
+  std::ranges::copy(std::array{0b1010'0000_b, 0b0100'0000_b,  // [0]
+                               0b0101'1111_b, 0b1000'0000_b},
+                    store.begin());
+  auto [store32, bmp] = create_bitmap32_and_store(10U, 2U);
+  bmp.expand(mono, mono.bounds(), draw::point{.x = 0, .y = 0}, red, blue);
+  EXPECT_THAT(store32, ElementsAre(r, b, r, b, b, b, b, b, b, r,  // [0]
+                                   b, r, b, r, r, r, r, r, r, b   // [1]
+                                   ));
+  EXPECT_EQ(bmp.dirty(), mono.bounds());
+}
+
+TEST(Expand, ForegroundOnly) {
+  auto [store, mono] = create_bitmap_and_store(9U, 1U);
+  std::ranges::copy(std::array{0b1000'0001_b, 0b1000'0000_b}, store.begin());
+  auto [store32, bmp] = create_bitmap32_and_store(9U, 1U);
+  std::ranges::fill(store32, b);
+  bmp.expand(mono, mono.bounds(), draw::point{.x = 0, .y = 0}, red);
+  EXPECT_THAT(store32, ElementsAre(r, b, b, b, b, b, b, r, r));
+}
+
+TEST(Expand, TranslucentForegroundComposites) {
+  auto [store, mono] = create_bitmap_and_store(2U, 1U);
+  std::ranges::copy(std::array{0b1000'0000_b}, store.begin());
+  auto [store32, bmp] = create_bitmap32_and_store(2U, 1U);
+  std::ranges::fill(store32, b);
+  auto const half_red = draw::rgba{.r = 0xFF, .g = 0x00, .b = 0x00, .a = 0x80};
+  bmp.expand(mono, mono.bounds(), draw::point{.x = 0, .y = 0}, half_red);
+  auto expected = b;
+  expected.composite(draw::rgba_premult{half_red});
+  EXPECT_THAT(store32, ElementsAre(expected, b));
+}
+
+TEST(Expand, SourceRect) {
+  // Expand a misaligned area from the middle of the 1bpp bitmap.
+  auto [store, mono] = create_bitmap_and_store(16U, 3U);
+  std::ranges::copy(std::array{0x00_b, 0x00_b,         // [0]
+                               0b0011'0110_b, 0x80_b,  // [1]
+                               0xFF_b, 0xFF_b},
+                    store.begin());
+  auto [store32, bmp] = create_bitmap32_and_store(8U, 3U);
+  auto const src_rect = draw::rect{.top = 1, .left = 3, .bottom = 1, .right = 8};
+  bmp.expand(mono, src_rect, draw::point{.x = 1, .y = 1}, red, blue);
+  EXPECT_THAT(store32, ElementsAre(x, x, x, x, x, x, x, x,  // [0]
+                                   x, r, b, r, r, b, r, x,  // [1]
+                                   x, x, x, x, x, x, x, x   // [2]
+                                   ));
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 1, .left = 1, .bottom = 1, .right = 6}));
+}
+
+TEST(Expand, ClippedTopLeft) {
+  auto [store, mono] = create_bitmap_and_store(4U, 4U);
+  std::ranges::copy(std::array{0b1000'0000_b, 0b0100'0000_b, 0b0010'0000_b, 0b0001'0000_b}, store.begin());
+  auto [store32, bmp] = create_bitmap32_and_store(3U, 3U);
+  bmp.expand(mono, mono.bounds(), draw::point{.x = -1, .y = -1}, red, blue);
+  EXPECT_THAT(store32, ElementsAre(r, b, b,  // [0]
+                                   b, r, b,  // [1]
+                                   b, b, r   // [2]
+                                   ));
+  EXPECT_EQ(bmp.dirty(), bmp.bounds());
+}
+
+TEST(Expand, ClippedBottomRight) {
+  auto [store, mono] = create_bitmap_and_store(4U, 4U);
+  std::ranges::fill(store, 0xF0_b);
+  auto [store32, bmp] = create_bitmap32_and_store(3U, 3U);
+  bmp.expand(mono, draw::rect{.top = -2, .left = -2, .bottom = 9, .right = 9}, draw::point{.x = 0, .y = 0}, red, blue);
+  EXPECT_THAT(store32, ElementsAre(x, x, x,  // [0]
+                                   x, x, x,  // [1]
+                                   x, x, r   // [2]
+                                   ));
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 2, .left = 2, .bottom = 2, .right = 2}));
+}
+
+TEST(Expand, Outside) {
+  auto [store, mono] = create_bitmap_and_store(4U, 4U);
+  std::ranges::fill(store, 0xF0_b);
+  auto [store32, bmp] = create_bitmap32_and_store(3U, 3U);
+  bmp.expand(mono, mono.bounds(), draw::point{.x = 3, .y = 0}, red, blue);
+  bmp.expand(mono, mono.bounds(), draw::point{.x = 0, .y = -4}, red, blue);
+  EXPECT_THAT(store32, testing::Each(x));
+  EXPECT_FALSE(bmp.dirty().has_value());
+}
+
+}  // end anonymous namespace
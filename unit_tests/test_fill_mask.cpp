@@ -0,0 +1,121 @@
+//===- unit_tests/test_fill_mask.cpp --------------------------------------===//
+//*   __ _ _ _                       _     *
+//*  / _(_) | |  _ __ ___   __ _ ___| | __ *
+//* | |_| | | | | '_ ` _ \ / _` / __| |/ / *
+//* |  _| | | | | | | | | | (_| \__ \   <  *
+//* |_| |_|_|_| |_| |_| |_|\__,_|___/_|\_\ *
+//*                                        *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/alpha8.hpp"
+#include "draw/basic_bitmap.hpp"
+#include "draw/bitmap32.hpp"
+
+// Standard library
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+
+using testing::ElementsAre;
+
+namespace {
+
+constexpr auto red = draw::rgba{.r = 0xFF, .g = 0x00, .b = 0x00};
+constexpr auto r = draw::rgba_premult{red};
+constexpr auto x = draw::rgba_premult{};
+
+// Returns a reproducible sequence of bytes in which zero and 0xFF are common.
+std::vector<std::uint8_t> coverage(std::size_t const size, std::uint32_t seed) {
+  std::vector<std::uint8_t> result(size);
+  for (auto& c : result) {
+    seed = seed * 1664525U + 1013904223U;
+    auto const v = static_cast<std::uint8_t>(seed >> 24);
+    c = v < 0x40U ? std::uint8_t{0} : (v > 0xC0U ? std::uint8_t{0xFF} : v);
+  }
+  return result;
+}
+
+/// The scalar equivalent of compositing \p color scaled by \p c over \p px.
+draw::rgba_premult reference(draw::rgba_premult px, draw::rgba_premult const& color, unsigned const c) {
+  auto const mul = [c](std::uint8_t const v) {
+    auto const p = static_cast<unsigned>(v) * c;
+    return static_cast<std::uint8_t>((p + 0x80U + (p >> 8U)) >> 8U);
+  };
+  return px.composite(draw::rgba_premult{mul(color.r), mul(color.g), mul(color.b), mul(color.a)});
+}
+
+TEST(FillMask, Simple) {
+  std::vector<std::uint8_t> mask_store{0x00, 0xFF, 0x80};
+  draw::alpha8 const mask{mask_store, 3U, 1U};
+  auto [store, bmp] = create_bitmap32_and_store(4U, 2U);
+  bmp.fill_mask(mask, draw::point{.x = 1, .y = 1}, red);
+  EXPECT_THAT(store, ElementsAre(x, x, x, x,  // [0]
+                                 x, x, r, draw::rgba_premult{0x80, 0x00, 0x00}));
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 1, .left = 1, .bottom = 1, .right = 3}));
+}
+
+TEST(FillMask, MatchesReference) {
+  constexpr auto color = draw::rgba{.r = 0x20, .g = 0x90, .b = 0xF0, .a = 0xC0};
+  constexpr auto c = draw::rgba_premult{color};
+  // An odd width ensures that the partial blocks at the end of each row are exercised.
+  auto mask_store = coverage(draw::alpha8::required_store_size(23U, 5U), 1U);
+  draw::alpha8 const mask{mask_store, 23U, 5U};
+  auto [store, bmp] = create_bitmap32_and_store(30U, 9U);
+  for (auto index = 0U; index < store.size(); ++index) {
+    auto const v = static_cast<std::uint8_t>(index * 7U);
+    store[index] = draw::rgba_premult{draw::rgba{.r = v, .g = 0x40, .b = 0x10, .a = static_cast<std::uint8_t>(~v)}};
+  }
+  auto expected = store;
+  for (auto y = 0U; y < mask.height(); ++y) {
+    for (auto x = 0U; x < mask.width(); ++x) {
+      auto& px = expected[(y + 2U) * bmp.stride() + x + 3U];
+      px = reference(px, c, mask_store[y * mask.stride() + x]);
+    }
+  }
+  bmp.fill_mask(mask, draw::point{.x = 3, .y = 2}, color);
+  EXPECT_EQ(store, expected);
+}
+
+TEST(FillMask, Clipped) {
+  std::vector<std::uint8_t> mask_store(draw::alpha8::required_store_size(4U, 4U), std::uint8_t{0xFF});
+  draw::alpha8 const mask{mask_store, 4U, 4U};
+  auto [store, bmp] = create_bitmap32_and_store(3U, 3U);
+  bmp.fill_mask(mask, draw::point{.x = -2, .y = 1}, red);
+  EXPECT_THAT(store, ElementsAre(x, x, x,  // [0]
+                                 r, r, x,  // [1]
+                                 r, r, x   // [2]
+                                 ));
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 1, .left = 0, .bottom = 2, .right = 1}));
+}
+
+}  // end anonymous namespace
@@ -51,8 +51,14 @@ TEST(Font, FindGlyphLatinSmallLetterA) {
   draw::glyph const* const g = draw::sans16.find_glyph(U'a');
   ASSERT_NE(g, nullptr);
   EXPECT_TRUE(g->kerns.empty());
-  EXPECT_THAT(g->bm, ElementsAre(0x80_b, 0x0C_b, 0x40_b, 0x12_b, 0x40_b, 0x12_b, 0x40_b, 0x12_b, 0x80_b, 0x1F_b, 0x00_b,
-                                 0x10_b));
+  if (draw::sans16.layout == draw::glyph_layout::row_major) {
+    EXPECT_EQ(draw::sans16.width(*g), 6U);
+    EXPECT_THAT(g->bm, ElementsAre(0x00_b, 0x00_b, 0x00_b, 0x00_b, 0x00_b, 0x00_b, 0x70_b, 0x88_b, 0x08_b, 0x78_b, 0x88_b,
+                                   0x88_b, 0x7C_b, 0x00_b, 0x00_b, 0x00_b));
+  } else {
+    EXPECT_THAT(g->bm, ElementsAre(0x80_b, 0x0C_b, 0x40_b, 0x12_b, 0x40_b, 0x12_b, 0x40_b, 0x12_b, 0x80_b, 0x1F_b,
+                                   0x00_b, 0x10_b));
+  }
 }
 
 TEST(Font, FindMissingGlyph) {
@@ -68,7 +74,7 @@ TEST(Font, FindMissingGlyphNoWhiteSqaure) {
                                       .spacing = 1,
                                       .glyphs = draw::font::glyph_map{
                                           {0x20, draw::glyph{decltype(draw::glyph::kerns)::from_array(draw::empty_kern),
-                                                             decltype(draw::glyph::bm)::from_array(bitmap_0020)}},
+                                                             decltype(draw::glyph::bm)::from_array(bitmap_0020), 2U}},
                                       }};
   EXPECT_EQ(minimal.find_glyph(char32_t{0x0600U}), minimal.find_glyph(char32_t{0x20U}));
 }
@@ -0,0 +1,105 @@
+//===- unit_tests/test_glyph_atlas.cpp ------------------------------------===//
+//*        _             _             _   _            *
+//*   __ _| |_   _ _ __ | |__     __ _| |_| | __ _ ___  *
+//*  / _` | | | | | '_ \| '_ \   / _` | __| |/ _` / __| *
+//* | (_| | | |_| | |_) | | | | | (_| | |_| | (_| \__ \ *
+//*  \__, |_|\__, | .__/|_| |_|  \__,_|\__|_|\__,_|___/ *
+//*  |___/   |___/|_|                                   *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/glyph_atlas.hpp"
+
+// Standard library
+#include <cstddef>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+#include "draw/glyph_cache.hpp"
+#include "draw/sans16.hpp"
+#include "draw/sans32.hpp"
+
+namespace {
+
+// The atlas is built entirely at compile time.
+static_assert(draw::glyph_atlas<draw::sans16>::find(U'A').width() ==
+              draw::sans16.width(*draw::sans16.find_glyph(U'A')));
+static_assert(draw::glyph_atlas<draw::sans16>::find(U'A').height() == draw::sans16.height * 8U);
+
+template <typename T> class GlyphAtlas : public testing::Test {};
+template <draw::font const& Font> struct font_holder {
+  static constexpr auto const& font = Font;
+};
+using fonts = testing::Types<font_holder<draw::sans16>, font_holder<draw::sans32>>;
+TYPED_TEST_SUITE(GlyphAtlas, fonts);
+
+// Every glyph in the atlas must be identical to the glyph rendered at run time by the cache.
+TYPED_TEST(GlyphAtlas, MatchesGlyphCache) {
+  constexpr auto const& font = TypeParam::font;
+  draw::glyph_atlas<font> atlas;
+  std::vector store{draw::glyph_cache::get_size(font), std::byte{0U}};
+  draw::glyph_cache gc{font, store};
+  for (auto const& [code_point, g] : font.glyphs) {
+    auto const cp = static_cast<char32_t>(code_point);
+    auto const& expected = gc.get(font, cp);
+    auto const& actual = atlas.get(font, cp);
+    ASSERT_EQ(actual.width(), expected.width()) << "code point " << code_point;
+    ASSERT_EQ(actual.height(), expected.height()) << "code point " << code_point;
+    for (auto y = draw::coordinate{0}; y < static_cast<draw::coordinate>(expected.height()); ++y) {
+      for (auto x = draw::coordinate{0}; x < static_cast<draw::coordinate>(expected.width()); ++x) {
+        auto const p = draw::point{.x = x, .y = y};
+        EXPECT_EQ(actual.get(p), expected.get(p)) << "code point " << code_point << " at (" << x << ',' << y << ')';
+      }
+    }
+  }
+}
+
+TYPED_TEST(GlyphAtlas, MissingCodePoint) {
+  constexpr auto const& font = TypeParam::font;
+  using atlas = draw::glyph_atlas<font>;
+  constexpr auto missing = char32_t{0x1F600};
+  ASSERT_EQ(font.glyphs.find(missing), font.glyphs.end());
+  EXPECT_EQ(&atlas::find(missing), &atlas::find(draw::white_square));
+}
+
+TEST(GlyphAtlas, DrawString) {
+  auto [expected_store, expected] = create_bitmap_and_store(64U, 16U);
+  std::vector glyph_cache_store{draw::glyph_cache::get_size(draw::sans16), std::byte{0U}};
+  draw::glyph_cache gc{draw::sans16, glyph_cache_store};
+  auto const expected_end = expected.draw_string(gc, draw::sans16, u8"Atlas", draw::point{.x = 1, .y = 0});
+
+  auto [actual_store, actual] = create_bitmap_and_store(64U, 16U);
+  draw::glyph_atlas<draw::sans16> atlas;
+  auto const actual_end = actual.draw_string(atlas, draw::sans16, u8"Atlas", draw::point{.x = 1, .y = 0});
+  EXPECT_EQ(actual_end, expected_end);
+  EXPECT_EQ(actual_store, expected_store);
+}
+
+}  // end anonymous namespace
@@ -0,0 +1,243 @@
+//===- unit_tests/test_glyph_cache.cpp ------------------------------------===//
+//*        _             _                      _           *
+//*   __ _| |_   _ _ __ | |__     ___ __ _  ___| |__   ___  *
+//*  / _` | | | | | '_ \| '_ \   / __/ _` |/ __| '_ \ / _ \ *
+//* | (_| | | |_| | |_) | | | | | (_| (_| | (__| | | |  __/ *
+//*  \__, |_|\__, | .__/|_| |_|  \___\__,_|\___|_| |_|\___| *
+//*  |___/   |___/|_|                                       *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/glyph_cache.hpp"
+
+#include "draw/glyph_atlas.hpp"
+
+// Standard library
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "draw/all_fonts.hpp"
+#include "draw/sans16.hpp"
+#include "draw/sans32.hpp"
+
+namespace {
+
+TEST(GlyphCache, SizeFollowsGeometry) {
+  using small_cache = draw::basic_glyph_cache<8U, 2U>;
+  using large_cache = draw::basic_glyph_cache<32U, 4U, 2U>;
+  EXPECT_EQ(draw::glyph_cache::get_size(draw::sans16), small_cache::get_size(draw::sans16));
+  EXPECT_EQ(large_cache::get_size(draw::all_fonts), small_cache::get_size(draw::all_fonts) * 8U);
+  EXPECT_EQ(large_cache::get_size(draw::all_fonts), large_cache::get_size(draw::sans32));
+}
+
+TEST(GlyphCache, Hit) {
+  using cache = draw::basic_glyph_cache<4U, 2U>;
+  std::vector store{cache::get_size(draw::sans16), std::byte{0U}};
+  cache gc{draw::sans16, store};
+  EXPECT_FALSE(gc.contains(draw::sans16, U'A'));
+  auto const& first = gc.get(draw::sans16, U'A');
+  EXPECT_TRUE(gc.contains(draw::sans16, U'A'));
+  EXPECT_EQ(&gc.get(draw::sans16, U'A'), &first);
+}
+
+TEST(GlyphCache, FontsShareSetsWithoutPartitions) {
+  // A single way in each of two sets: the same code point from two fonts maps to the same slot.
+  using cache = draw::basic_glyph_cache<2U, 1U>;
+  std::vector store{cache::get_size(draw::all_fonts), std::byte{0U}};
+  cache gc{draw::all_fonts, store};
+  std::ignore = gc.get(draw::sans16, U'A');
+  std::ignore = gc.get(draw::sans32, U'A');
+  EXPECT_FALSE(gc.contains(draw::sans16, U'A'));
+  EXPECT_TRUE(gc.contains(draw::sans32, U'A'));
+}
+
+TEST(GlyphCache, PartitionsIsolateFonts) {
+  using cache = draw::basic_glyph_cache<2U, 1U, 2U>;
+  std::vector store{cache::get_size(draw::all_fonts), std::byte{0U}};
+  cache gc{draw::all_fonts, store};
+  std::ignore = gc.get(draw::sans16, U'A');
+  std::ignore = gc.get(draw::sans32, U'A');
+  std::ignore = gc.get(draw::sans32, U'B');
+  EXPECT_TRUE(gc.contains(draw::sans16, U'A'));
+  EXPECT_FALSE(gc.contains(draw::sans32, U'A'));
+  EXPECT_TRUE(gc.contains(draw::sans32, U'B'));
+}
+
+TEST(GlyphCache, PartitionedKeysAreDistinct) {
+  using cache = draw::basic_glyph_cache<16U, 2U, 4U>;
+  EXPECT_NE(cache::key(1U, U'A'), cache::key(2U, U'A'));
+  EXPECT_NE(cache::key(1U, U'A'), cache::key(5U, U'A'));
+  // Bits 2 and 3 of the key select the partition; bits 0 and 1 come from the code point.
+  EXPECT_EQ(cache::key(1U, U'A') & 0b1111U, 0b0101U);
+  EXPECT_EQ(cache::key(2U, U'A') & 0b1111U, 0b1001U);
+}
+
+TEST(GlyphCache, Stats) {
+  // Two sets of one way each.
+  using cache = draw::basic_glyph_cache<2U, 1U, 1U, true>;
+  std::vector store{cache::get_size(draw::all_fonts), std::byte{0U}};
+  cache gc{draw::all_fonts, store};
+  std::ignore = gc.get(draw::sans16, U'A');  // miss
+  std::ignore = gc.get(draw::sans16, U'A');  // hit
+  std::ignore = gc.get(draw::sans16, U'B');  // miss (the other set)
+  std::ignore = gc.get(draw::sans32, U'A');  // miss, evicts sans16 'A'
+  std::ignore = gc.get(draw::sans16, U'B');  // hit
+
+  auto const stats = gc.stats();
+  EXPECT_EQ(stats.hits, 2U);
+  EXPECT_EQ(stats.misses, 3U);
+  EXPECT_EQ(stats.evictions, 1U);
+  EXPECT_EQ(stats.font_misses[draw::sans16.id], 2U);
+  EXPECT_EQ(stats.font_misses[draw::sans32.id], 1U);
+  if (DRAW_HOSTED) {
+    EXPECT_GT(stats.render_ns, 0U);
+  }
+
+  gc.reset_stats();
+  std::ignore = gc.get(draw::sans16, U'A');  // miss, evicts sans32 'A'
+  auto const after = gc.stats();
+  EXPECT_EQ(after.hits, 0U);
+  EXPECT_EQ(after.misses, 1U);
+  EXPECT_EQ(after.evictions, 1U);
+  EXPECT_EQ(after.font_misses[draw::sans32.id], 0U);
+}
+
+TEST(GlyphCache, WarmString) {
+  std::vector store{draw::glyph_cache::get_size(draw::sans16), std::byte{0U}};
+  draw::glyph_cache gc{draw::sans16, store};
+  EXPECT_TRUE(gc.warm(draw::sans16, u8"Hello"));
+  for (auto const cp : {U'H', U'e', U'l', U'o'}) {
+    EXPECT_TRUE(gc.contains(draw::sans16, cp));
+  }
+}
+
+TEST(GlyphCache, WarmRange) {
+  // 8 sets of 2 ways: 16 consecutive code points fill the cache exactly.
+  std::vector store{draw::glyph_cache::get_size(draw::sans16), std::byte{0U}};
+  draw::glyph_cache gc{draw::sans16, store};
+  EXPECT_TRUE(gc.warm(draw::sans16, U'A', U'P'));
+  EXPECT_TRUE(gc.contains(draw::sans16, U'A'));
+  EXPECT_TRUE(gc.contains(draw::sans16, U'P'));
+  EXPECT_FALSE(gc.warm(draw::sans16, U'A', U'Q'));
+  EXPECT_TRUE(gc.contains(draw::sans16, U'Q'));
+}
+
+TEST(GlyphCache, SmallGlyphsShareStorage) {
+  // Storage for one of the largest sans32 glyphs in each set has room for many narrow sans16 glyphs.
+  using cache = draw::basic_glyph_cache<2U, 8U>;
+  std::vector store{draw::glyph_cache::get_size(draw::sans32) / draw::glyph_cache::ways / 4U, std::byte{0U}};
+  cache gc{draw::all_fonts, store};
+  EXPECT_TRUE(gc.warm(draw::sans16, u8"il.,:;!|"));
+
+  // A large glyph displaces the small ones.
+  std::ignore = gc.get(draw::sans32, U'W');
+  EXPECT_TRUE(gc.contains(draw::sans32, U'W'));
+  EXPECT_FALSE(gc.contains(draw::sans16, U'i'));
+}
+
+// Requests glyphs from both fonts in a store that is too small to hold them all and checks each result against the
+// pre-rendered atlas. Glyphs that survive eviction are moved within the store so this checks that the bitmaps of
+// the cached glyphs continue to refer to the right pixels.
+TEST(GlyphCache, EvictionPreservesGlyphs) {
+  using cache = draw::basic_glyph_cache<2U, 8U, 1U, true>;
+  std::vector store{draw::glyph_cache::get_size(draw::all_fonts) / draw::glyph_cache::ways, std::byte{0U}};
+  cache gc{draw::all_fonts, store};
+  auto seed = std::uint32_t{1};
+  for (auto ctr = 0U; ctr < 2000U; ++ctr) {
+    seed = seed * 1664525U + 1013904223U;
+    auto const code_point = static_cast<char32_t>(U'0' + (seed >> 16U) % 64U);
+    auto const& f = (seed >> 28U) % 2U == 0U ? draw::sans16 : draw::sans32;
+    auto const& actual = gc.get(f, code_point);
+    auto const& expected = (&f == &draw::sans16) ? draw::glyph_atlas<draw::sans16>::find(code_point)
+                                                  : draw::glyph_atlas<draw::sans32>::find(code_point);
+    ASSERT_EQ(actual.width(), expected.width());
+    ASSERT_EQ(actual.height(), expected.height());
+    for (auto y = draw::coordinate{0}; y < static_cast<draw::coordinate>(expected.height()); ++y) {
+      for (auto x = draw::coordinate{0}; x < static_cast<draw::coordinate>(expected.width()); ++x) {
+        auto const p = draw::point{.x = x, .y = y};
+        ASSERT_EQ(actual.get(p), expected.get(p)) << "request " << ctr << " U+" << std::hex
+                                                  << static_cast<std::uint32_t>(code_point);
+      }
+    }
+  }
+  auto const stats = gc.stats();
+  EXPECT_GT(stats.hits, 0U);
+  EXPECT_GT(stats.evictions, 0U);
+}
+
+// Renders a glyph of the given width with pseudo-random pixels and checks every pixel of the result.
+class GlyphCacheRender : public testing::TestWithParam<std::uint8_t> {};
+
+TEST_P(GlyphCacheRender, MatchesColumns) {
+  using namespace draw::literals;
+  auto const width = GetParam();
+  constexpr auto height = std::uint8_t{2};
+  std::vector<std::byte> columns(std::size_t{width} * height);
+  auto seed = std::uint32_t{width};
+  for (auto& b : columns) {
+    seed = seed * 1664525U + 1013904223U;
+    b = static_cast<std::byte>(seed >> 24U);
+  }
+  draw::font const f{.id = 0xFF,
+                     .baseline = 12,
+                     .widest = width,
+                     .height = height,
+                     .spacing = 1,
+                     .glyphs = draw::font::glyph_map{
+                         {0x20, draw::glyph{.kerns = decltype(draw::glyph::kerns)::from_array(draw::empty_kern),
+                                            .bm = {.data_ = columns.data(), .size_ = columns.size()},
+                                            .width = width}},
+                     }};
+
+  // Start with a dirty store so that bits which are not written are detected.
+  std::vector store{draw::glyph_cache::get_size(f), 0xFF_b};
+  draw::glyph_cache gc{f, store};
+  auto const& bm = gc.get(f, U' ');
+  ASSERT_EQ(bm.width(), width);
+  ASSERT_EQ(bm.height(), height * 8U);
+  for (auto y = 0U; y < bm.height(); ++y) {
+    for (auto x = 0U; x < bm.width(); ++x) {
+      auto const expected = (columns[x * height + y / 8U] & (std::byte{1} << (y % 8U))) != std::byte{0};
+      EXPECT_EQ(bm.get(draw::point{.x = static_cast<draw::coordinate>(x), .y = static_cast<draw::coordinate>(y)}),
+                expected)
+          << "x=" << x << " y=" << y;
+    }
+    // The padding at the end of the row is clear.
+    auto const last = bm.store()[y * bm.stride() + bm.stride() - 1U];
+    auto const padding = static_cast<std::byte>(0xFFU >> (((width - 1U) % 8U) + 1U));
+    EXPECT_EQ(last & padding, std::byte{0}) << "y=" << y;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Widths, GlyphCacheRender, testing::Values(1, 7, 8, 9, 15, 16, 17, 24, 25, 33));
+
+}  // end anonymous namespace
@@ -0,0 +1,186 @@
+//===- unit_tests/test_gradient.cpp ---------------------------------------===//
+//*                      _ _            _    *
+//*   __ _ _ __ __ _  __| (_) ___ _ __ | |_  *
+//*  / _` | '__/ _` |/ _` | |/ _ \ '_ \| __| *
+//* | (_| | | | (_| | (_| | |  __/ | | | |_  *
+//*  \__, |_|  \__,_|\__,_|_|\___|_| |_|\__| *
+//*  |___/                                   *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/bitmap32.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+
+using testing::Each;
+using testing::ElementsAre;
+using gradient_kind = draw::bitmap32::gradient_kind;
+using gradient_stop = draw::bitmap32::gradient_stop;
+
+namespace {
+
+constexpr draw::rgba_premult gray(std::uint8_t const v) {
+  return draw::rgba_premult{v, v, v, 0xFF};
+}
+
+// A ramp in which the color at each position has the same value as the position.
+constexpr std::array black_to_white{
+    gradient_stop{.position = 0x00, .color = draw::rgba{.r = 0x00, .g = 0x00, .b = 0x00}},
+    gradient_stop{.position = 0xFF, .color = draw::rgba{.r = 0xFF, .g = 0xFF, .b = 0xFF}},
+};
+
+TEST(Gradient, LinearHorizontal) {
+  auto [store, bmp] = create_bitmap32_and_store(256U, 2U);
+  bmp.paint_gradient(bmp.bounds(), black_to_white, gradient_kind::linear, draw::point{.x = 0, .y = 0},
+                     draw::point{.x = 255, .y = 0});
+  for (auto x = 0U; x < 256U; ++x) {
+    EXPECT_EQ(store[x], gray(static_cast<std::uint8_t>(x))) << "x=" << x;
+    EXPECT_EQ(store[256U + x], gray(static_cast<std::uint8_t>(x))) << "x=" << x;
+  }
+  EXPECT_EQ(bmp.dirty(), bmp.bounds());
+}
+
+TEST(Gradient, LinearVertical) {
+  auto [store, bmp] = create_bitmap32_and_store(3U, 5U);
+  bmp.paint_gradient(bmp.bounds(), black_to_white, gradient_kind::linear, draw::point{.x = 0, .y = 1},
+                     draw::point{.x = 0, .y = 3});
+  // Pixels before the start and after the end take the colors of the first and last stops.
+  EXPECT_THAT(store, ElementsAre(gray(0x00), gray(0x00), gray(0x00),  // [0]
+                                 gray(0x00), gray(0x00), gray(0x00),  // [1]
+                                 gray(0x7F), gray(0x7F), gray(0x7F),  // [2]
+                                 gray(0xFF), gray(0xFF), gray(0xFF),  // [3]
+                                 gray(0xFF), gray(0xFF), gray(0xFF)));
+}
+
+TEST(Gradient, LinearDiagonal) {
+  auto [store, bmp] = create_bitmap32_and_store(3U, 3U);
+  bmp.paint_gradient(bmp.bounds(), black_to_white, gradient_kind::linear, draw::point{.x = 0, .y = 0},
+                     draw::point{.x = 2, .y = 2});
+  // Pixels on lines perpendicular to the gradient share a color.
+  EXPECT_THAT(store, ElementsAre(gray(0x00), gray(0x3F), gray(0x7F),  // [0]
+                                 gray(0x3F), gray(0x7F), gray(0xBF),  // [1]
+                                 gray(0x7F), gray(0xBF), gray(0xFF)));
+}
+
+TEST(Gradient, LongLinearMatchesExact) {
+  // A run longer than the library's row chunk checks that stepping does not drift from the exact positions.
+  constexpr auto width = std::uint16_t{700};
+  auto [store, bmp] = create_bitmap32_and_store(width, 1U);
+  auto const start = draw::point{.x = 13, .y = 0};
+  auto const end = draw::point{.x = 677, .y = 0};
+  bmp.paint_gradient(bmp.bounds(), black_to_white, gradient_kind::linear, start, end);
+  for (auto x = 0; x < width; ++x) {
+    auto const expected = std::clamp((x - start.x) * 255 / (end.x - start.x), 0, 255);
+    EXPECT_EQ(store[static_cast<std::size_t>(x)], gray(static_cast<std::uint8_t>(expected))) << "x=" << x;
+  }
+}
+
+TEST(Gradient, Radial) {
+  auto [store, bmp] = create_bitmap32_and_store(21U, 21U);
+  bmp.paint_gradient(bmp.bounds(), black_to_white, gradient_kind::radial, draw::point{.x = 10, .y = 10},
+                     draw::point{.x = 10, .y = 265});
+  // With a radius of 255, each pixel's value is its distance from the center rounded down.
+  auto const at = [&](std::size_t const x, std::size_t const y) { return store[y * 21U + x]; };
+  EXPECT_EQ(at(10, 10), gray(0));
+  EXPECT_EQ(at(13, 14), gray(5));
+  EXPECT_EQ(at(0, 10), gray(10));
+  EXPECT_EQ(at(11, 11), gray(1));
+  EXPECT_EQ(at(0, 0), gray(14));
+}
+
+TEST(Gradient, RadialMatchesExact) {
+  constexpr auto width = std::uint16_t{150};
+  constexpr auto height = std::uint16_t{40};
+  auto [store, bmp] = create_bitmap32_and_store(width, height);
+  auto const center = draw::point{.x = 61, .y = 17};
+  auto const edge = draw::point{.x = 100, .y = 30};
+  bmp.paint_gradient(bmp.bounds(), black_to_white, gradient_kind::radial, center, edge);
+  auto const radius2 =
+      std::int64_t{(edge.x - center.x) * (edge.x - center.x) + (edge.y - center.y) * (edge.y - center.y)};
+  for (auto y = 0; y < height; ++y) {
+    for (auto x = 0; x < width; ++x) {
+      auto const distance2 = std::int64_t{(x - center.x) * (x - center.x) + (y - center.y) * (y - center.y)};
+      auto expected = 0;
+      while (expected < 255 && (expected + 1) * (expected + 1) * radius2 <= distance2 * 255 * 255) {
+        ++expected;
+      }
+      EXPECT_EQ(store[static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x)],
+                gray(static_cast<std::uint8_t>(expected)))
+          << "x=" << x << " y=" << y;
+    }
+  }
+}
+
+TEST(Gradient, Stops) {
+  constexpr auto red = draw::rgba{.r = 0xFF, .g = 0x00, .b = 0x00};
+  constexpr auto blue = draw::rgba{.r = 0x00, .g = 0x00, .b = 0xFF};
+  constexpr std::array stops{
+      gradient_stop{.position = 0x40, .color = red},
+      gradient_stop{.position = 0x80, .color = blue},
+      gradient_stop{.position = 0x80, .color = red},  // A hard edge.
+  };
+  auto [store, bmp] = create_bitmap32_and_store(256U, 1U);
+  bmp.paint_gradient(bmp.bounds(), stops, gradient_kind::linear, draw::point{.x = 0, .y = 0},
+                     draw::point{.x = 255, .y = 0});
+  EXPECT_EQ(store[0x00], draw::rgba_premult{red});
+  EXPECT_EQ(store[0x40], draw::rgba_premult{red});
+  EXPECT_EQ(store[0x60], (draw::rgba_premult{0x80, 0x00, 0x80}));
+  EXPECT_EQ(store[0x7F], (draw::rgba_premult{0x04, 0x00, 0xFB}));
+  EXPECT_EQ(store[0x80], draw::rgba_premult{red});
+  EXPECT_EQ(store[0xFF], draw::rgba_premult{red});
+}
+
+TEST(Gradient, TranslucentIsComposited) {
+  constexpr std::array stops{gradient_stop{.position = 0, .color = draw::rgba{.r = 0xFF, .g = 0, .b = 0, .a = 0x80}}};
+  auto [store, bmp] = create_bitmap32_and_store(2U, 2U);
+  std::ranges::fill(store, gray(0xFF));
+  bmp.paint_gradient(bmp.bounds(), stops, gradient_kind::radial, draw::point{}, draw::point{.x = 1, .y = 1});
+  auto expected = gray(0xFF);
+  expected.composite(draw::rgba_premult{stops[0].color});
+  EXPECT_THAT(store, Each(expected));
+}
+
+TEST(Gradient, Clipped) {
+  auto [store, bmp] = create_bitmap32_and_store(4U, 2U);
+  bmp.paint_gradient(draw::rect{.top = -3, .left = 2, .bottom = 0, .right = 9}, black_to_white, gradient_kind::linear,
+                     draw::point{.x = 0, .y = 0}, draw::point{.x = 3, .y = 0});
+  EXPECT_THAT(store, ElementsAre(gray(0x00), gray(0x00), gray(0xAA), gray(0xFF),  // [0]
+                                 gray(0x00), gray(0x00), gray(0x00), gray(0x00)));
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 0, .left = 2, .bottom = 0, .right = 3}));
+}
+
+}  // end anonymous namespace
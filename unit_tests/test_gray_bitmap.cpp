@@ -0,0 +1,203 @@
+//===- unit_tests/test_gray_bitmap.cpp ------------------------------------===//
+//*                          _     _ _                          *
+//*   __ _ _ __ __ _ _   _  | |__ (_) |_ _ __ ___   __ _ _ __   *
+//*  / _` | '__/ _` | | | | | '_ \| | __| '_ ` _ \ / _` | '_ \  *
+//* | (_| | | | (_| | |_| | | |_) | | |_| | | | | | (_| | |_) | *
+//*  \__, |_|  \__,_|\__, | |_.__/|_|\__|_| |_| |_|\__,_| .__/  *
+//*  |___/           |___/                              |_|     *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/gray_bitmap.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+#include "draw/all_fonts.hpp"
+#include "draw/glyph_cache.hpp"
+#include "draw/sans16.hpp"
+
+using testing::ElementsAre;
+using namespace draw::literals;
+using namespace std::string_view_literals;
+
+namespace {
+
+template <typename Bitmap>
+std::tuple<std::vector<std::byte>, Bitmap> create(std::uint16_t const width, std::uint16_t const height) {
+  std::vector store(Bitmap::required_store_size(width, height), std::byte{0});
+  return std::tuple(std::move(store), Bitmap{std::span{store}, width, height});
+}
+
+/// Fills a bitmap with arbitrary but repeatable pixel values.
+template <typename Bitmap> void fill(Bitmap& bmp, std::uint32_t seed) {
+  for (auto y = 0; y < bmp.height(); ++y) {
+    for (auto x = 0; x < bmp.width(); ++x) {
+      seed = seed * 1664525U + 1013904223U;
+      bmp.set({.x = static_cast<draw::coordinate>(x), .y = static_cast<draw::coordinate>(y)},
+              static_cast<std::uint8_t>((seed >> 24U) & Bitmap::format::max_value));
+    }
+  }
+  bmp.clean();
+}
+
+TEST(GrayBitmap, CopyAligned) {
+  auto [src_store, src] = create<draw::gray2_bitmap>(8U, 1U);
+  std::ranges::copy(std::array{0b00'01'10'11_b, 0b11'10'01'00_b}, src_store.begin());
+  auto [dest_store, dest] = create<draw::gray2_bitmap>(16U, 1U);
+  dest.copy(src, draw::point{.x = 4, .y = 0});
+  EXPECT_THAT(dest_store, ElementsAre(0_b, 0b00'01'10'11_b, 0b11'10'01'00_b, 0_b));
+  EXPECT_EQ(dest.dirty(), (draw::rect{.top = 0, .left = 4, .bottom = 0, .right = 11}));
+}
+
+TEST(GrayBitmap, CopyMisaligned) {
+  auto [src_store, src] = create<draw::gray4_bitmap>(3U, 1U);
+  std::ranges::copy(std::array{0x12_b, 0x30_b}, src_store.begin());
+  auto [dest_store, dest] = create<draw::gray4_bitmap>(6U, 1U);
+  std::ranges::copy(std::array{0xFF_b, 0xFF_b, 0xFF_b}, dest_store.begin());
+  dest.copy(src, draw::point{.x = 1, .y = 0});
+  EXPECT_THAT(dest_store, ElementsAre(0xF1_b, 0x23_b, 0xFF_b));
+}
+
+TEST(GrayBitmap, CopyClipped) {
+  auto [src_store, src] = create<draw::gray2_bitmap>(6U, 3U);
+  fill(src, 1U);
+  auto [dest_store, dest] = create<draw::gray2_bitmap>(4U, 2U);
+  dest.copy(src, draw::point{.x = -3, .y = -2});
+  EXPECT_EQ(dest.get({.x = 0, .y = 0}), src.get({.x = 3, .y = 2}));
+  EXPECT_EQ(dest.get({.x = 1, .y = 0}), src.get({.x = 4, .y = 2}));
+  EXPECT_EQ(dest.get({.x = 2, .y = 0}), src.get({.x = 5, .y = 2}));
+  EXPECT_EQ(dest.get({.x = 3, .y = 0}), 0U);
+  EXPECT_EQ(dest.get({.x = 0, .y = 1}), 0U);
+  EXPECT_EQ(dest.dirty(), (draw::rect{.top = 0, .left = 0, .bottom = 0, .right = 2}));
+}
+
+template <typename Bitmap> class GrayCopy : public testing::Test {};
+using GrayBitmaps = testing::Types<draw::gray2_bitmap, draw::gray4_bitmap>;
+TYPED_TEST_SUITE(GrayCopy, GrayBitmaps);
+
+// Compares copies between every combination of source and destination alignment against a pixel-at-a-time copy.
+TYPED_TEST(GrayCopy, MatchesReference) {
+  for (auto width = std::uint16_t{1}; width <= 20U; ++width) {
+    for (auto dest_x = draw::coordinate{-3}; dest_x < 9; ++dest_x) {
+      auto [src_store, src] = create<TypeParam>(width, 2U);
+      fill(src, width);
+      auto [dest_store, dest] = create<TypeParam>(24U, 2U);
+      fill(dest, 7U);
+      auto [ref_store, ref] = create<TypeParam>(24U, 2U);
+      fill(ref, 7U);
+
+      dest.copy(src, draw::point{.x = dest_x, .y = 0});
+      for (auto y = draw::coordinate{0}; y < 2; ++y) {
+        for (auto x = draw::coordinate{0}; x < static_cast<draw::coordinate>(width); ++x) {
+          ref.set({.x = static_cast<draw::coordinate>(dest_x + x), .y = y}, src.get({.x = x, .y = y}));
+        }
+      }
+      EXPECT_EQ(dest_store, ref_store) << "width=" << width << " dest_x=" << dest_x;
+      EXPECT_EQ(dest.dirty(), ref.dirty()) << "width=" << width << " dest_x=" << dest_x;
+    }
+  }
+}
+
+TEST(GrayBitmap, ExpandInkOnly) {
+  auto [mono_store, mono] = create_bitmap_and_store(10U, 1U);
+  std::ranges::copy(std::array{0b1010'0000_b, 0b0100'0000_b}, mono_store.begin());
+  auto [store, bmp] = create<draw::gray2_bitmap>(12U, 1U);
+  std::ranges::copy(std::array{0b01'01'01'01_b, 0b01'01'01'01_b, 0b01'01'01'01_b}, store.begin());
+  bmp.expand(mono, mono.bounds(), draw::point{.x = 1, .y = 0}, 3U);
+  EXPECT_THAT(store, ElementsAre(0b01'11'01'11_b, 0b01'01'01'01_b, 0b01'01'11'01_b));
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 0, .left = 1, .bottom = 0, .right = 10}));
+}
+
+TEST(GrayBitmap, ExpandInkAndPaper) {
+  auto [mono_store, mono] = create_bitmap_and_store(3U, 1U);
+  std::ranges::copy(std::array{0b1010'0000_b}, mono_store.begin());
+  auto [store, bmp] = create<draw::gray4_bitmap>(5U, 1U);
+  std::ranges::copy(std::array{0x11_b, 0x11_b, 0x10_b}, store.begin());
+  bmp.expand(mono, mono.bounds(), draw::point{.x = 1, .y = 0}, 0xCU, 0x2U);
+  EXPECT_THAT(store, ElementsAre(0x1C_b, 0x2C_b, 0x10_b));
+}
+
+template <typename Bitmap> class GrayDrawChar : public testing::Test {
+protected:
+  std::vector<std::byte> glyph_cache_store_ =
+      std::vector(draw::glyph_cache::get_size(draw::all_fonts), std::byte{0U});
+  draw::glyph_cache gc_{draw::all_fonts, glyph_cache_store_};
+
+  /// Checks that every pixel of \p bmp that is set in \p mono has the \p ink level and every other pixel \p paper.
+  static void expect_matches(draw::bitmap const& mono, Bitmap const& bmp, std::uint8_t ink, std::uint8_t paper) {
+    ASSERT_EQ(mono.width(), bmp.width());
+    ASSERT_EQ(mono.height(), bmp.height());
+    for (auto y = draw::coordinate{0}; y < static_cast<draw::coordinate>(bmp.height()); ++y) {
+      for (auto x = draw::coordinate{0}; x < static_cast<draw::coordinate>(bmp.width()); ++x) {
+        auto const p = draw::point{.x = x, .y = y};
+        EXPECT_EQ(bmp.get(p), mono.get(p) != 0U ? ink : paper) << "x=" << x << " y=" << y;
+      }
+    }
+    EXPECT_EQ(mono.dirty(), bmp.dirty());
+  }
+};
+TYPED_TEST_SUITE(GrayDrawChar, GrayBitmaps);
+
+TYPED_TEST(GrayDrawChar, Misaligned) {
+  auto [mono_store, mono] = create_bitmap_and_store(24U, 16U);
+  auto [store, bmp] = create<TypeParam>(24U, 16U);
+  store.assign(store.size(), TypeParam::format::replicate(1U));
+  mono.draw_char(this->gc_, draw::sans16, U'W', draw::point{.x = 3, .y = 1});
+  bmp.draw_char(this->gc_, draw::sans16, U'W', draw::point{.x = 3, .y = 1}, TypeParam::format::max_value);
+  this->expect_matches(mono, bmp, TypeParam::format::max_value, 1U);
+}
+
+TYPED_TEST(GrayDrawChar, ClippedTopLeft) {
+  auto [mono_store, mono] = create_bitmap_and_store(16U, 16U);
+  auto [store, bmp] = create<TypeParam>(16U, 16U);
+  mono.draw_char(this->gc_, draw::sans16, U'M', draw::point{.x = -5, .y = -4});
+  bmp.draw_char(this->gc_, draw::sans16, U'M', draw::point{.x = -5, .y = -4}, 2U);
+  this->expect_matches(mono, bmp, 2U, 0U);
+}
+
+TYPED_TEST(GrayDrawChar, String) {
+  auto [mono_store, mono] = create_bitmap_and_store(64U, 32U);
+  auto [store, bmp] = create<TypeParam>(64U, 32U);
+  auto const p1 = mono.draw_string(this->gc_, draw::sans32, u8"a1"sv, draw::point{.x = 1, .y = 0});
+  auto const p2 = bmp.draw_string(this->gc_, draw::sans32, u8"a1"sv, draw::point{.x = 1, .y = 0}, 3U);
+  EXPECT_EQ(p1, p2);
+  this->expect_matches(mono, bmp, 3U, 0U);
+}
+
+}  // end anonymous namespace
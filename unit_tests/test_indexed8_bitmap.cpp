@@ -0,0 +1,122 @@
+//===- unit_tests/test_indexed8_bitmap.cpp --------------------------------===//
+//*  _           _                   _  ___    _     _ _                          *
+//* (_)_ __   __| | _____  _____  __| |( _ )  | |__ (_) |_ _ __ ___   __ _ _ __   *
+//* | | '_ \ / _` |/ _ \ \/ / _ \/ _` |/ _ \  | '_ \| | __| '_ ` _ \ / _` | '_ \  *
+//* | | | | | (_| |  __/>  <  __/ (_| | (_) | | |_) | | |_| | | | | | (_| | |_) | *
+//* |_|_| |_|\__,_|\___/_/\_\___|\__,_|\___/  |_.__/|_|\__|_| |_| |_|\__,_| .__/  *
+//*                                                                       |_|     *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/indexed8_bitmap.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+#include "draw/all_fonts.hpp"
+#include "draw/glyph_cache.hpp"
+#include "draw/sans16.hpp"
+
+using testing::ElementsAre;
+using namespace draw::literals;
+using namespace std::string_view_literals;
+
+namespace {
+
+class Indexed8Bitmap : public testing::Test {
+protected:
+  std::vector<std::byte> glyph_cache_store_ =
+      std::vector(draw::glyph_cache::get_size(draw::all_fonts), std::byte{0U});
+  draw::glyph_cache gc_{draw::all_fonts, glyph_cache_store_};
+
+  /// Checks that every pixel of \p bmp that is set in \p mono has the value \p index and every other pixel \p paper.
+  static void expect_matches(draw::bitmap const& mono, draw::indexed8_bitmap const& bmp, std::uint8_t index,
+                             std::uint8_t paper) {
+    ASSERT_EQ(mono.width(), bmp.width());
+    ASSERT_EQ(mono.height(), bmp.height());
+    for (auto y = draw::coordinate{0}; y < static_cast<draw::coordinate>(bmp.height()); ++y) {
+      for (auto x = draw::coordinate{0}; x < static_cast<draw::coordinate>(bmp.width()); ++x) {
+        auto const p = draw::point{.x = x, .y = y};
+        EXPECT_EQ(bmp.get(p), mono.get(p) != 0U ? index : paper) << "x=" << x << " y=" << y;
+      }
+    }
+    EXPECT_EQ(mono.dirty(), bmp.dirty());
+  }
+};
+
+TEST_F(Indexed8Bitmap, Copy) {
+  std::vector<std::uint8_t> src_store{1, 2, 3, 4, 5, 6};
+  draw::indexed8_bitmap src{src_store, 3U, 2U};
+  std::vector<std::uint8_t> dest_store(draw::indexed8_bitmap::required_store_size(4U, 2U));
+  draw::indexed8_bitmap dest{dest_store, 4U, 2U};
+  dest.copy(src, draw::point{.x = 2, .y = -1});
+  EXPECT_THAT(dest_store, ElementsAre(0, 0, 4, 5,  // [0]
+                                      0, 0, 0, 0   // [1]
+                                      ));
+  EXPECT_EQ(dest.dirty(), (draw::rect{.top = 0, .left = 2, .bottom = 0, .right = 3}));
+}
+
+TEST_F(Indexed8Bitmap, Expand) {
+  auto [mono_store, mono] = create_bitmap_and_store(11U, 1U);
+  std::ranges::copy(std::array{0b1111'1111_b, 0b0100'0000_b}, mono_store.begin());
+  std::vector<std::uint8_t> store(12U, 9U);
+  draw::indexed8_bitmap bmp{store, 12U, 1U};
+  bmp.expand(mono, mono.bounds(), draw::point{.x = 1, .y = 0}, 7U);
+  EXPECT_THAT(store, ElementsAre(9, 7, 7, 7, 7, 7, 7, 7, 7, 9, 7, 9));
+  bmp.expand(mono, draw::rect{.top = 0, .left = 7, .bottom = 0, .right = 10}, draw::point{.x = 0, .y = 0}, 1U, 2U);
+  EXPECT_THAT(store, ElementsAre(1, 2, 1, 2, 7, 7, 7, 7, 7, 9, 7, 9));
+}
+
+TEST_F(Indexed8Bitmap, DrawChar) {
+  auto [mono_store, mono] = create_bitmap_and_store(24U, 16U);
+  std::vector<std::uint8_t> store(draw::indexed8_bitmap::required_store_size(24U, 16U), 3U);
+  draw::indexed8_bitmap bmp{store, 24U, 16U};
+  mono.draw_char(gc_, draw::sans16, U'W', draw::point{.x = 3, .y = 1});
+  bmp.draw_char(gc_, draw::sans16, U'W', draw::point{.x = 3, .y = 1}, 200U);
+  expect_matches(mono, bmp, 200U, 3U);
+}
+
+TEST_F(Indexed8Bitmap, DrawString) {
+  auto [mono_store, mono] = create_bitmap_and_store(64U, 32U);
+  std::vector<std::uint8_t> store(draw::indexed8_bitmap::required_store_size(64U, 32U));
+  draw::indexed8_bitmap bmp{store, 64U, 32U};
+  auto const p1 = mono.draw_string(gc_, draw::sans32, u8"a1"sv, draw::point{.x = 2, .y = 0});
+  auto const p8 = bmp.draw_string(gc_, draw::sans32, u8"a1"sv, draw::point{.x = 2, .y = 0}, 1U);
+  EXPECT_EQ(p1, p8);
+  expect_matches(mono, bmp, 1U, 0U);
+}
+
+}  // end anonymous namespace
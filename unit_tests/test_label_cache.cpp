@@ -0,0 +1,152 @@
+//===- unit_tests/test_label_cache.cpp ------------------------------------===//
+//*  _       _          _                  _           *
+//* | | __ _| |__   ___| |   ___ __ _  ___| |__   ___  *
+//* | |/ _` | '_ \ / _ \ |  / __/ _` |/ __| '_ \ / _ \ *
+//* | | (_| | |_) |  __/ | | (_| (_| | (__| | | |  __/ *
+//* |_|\__,_|_.__/ \___|_|  \___\__,_|\___|_| |_|\___| *
+//*                                                    *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/label_cache.hpp"
+
+// Standard library
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+#include "draw/all_fonts.hpp"
+#include "draw/glyph_cache.hpp"
+#include "draw/sans16.hpp"
+#include "draw/sans32.hpp"
+
+using namespace std::string_view_literals;
+
+namespace {
+
+class LabelCache : public testing::Test {
+protected:
+  std::vector<std::byte> glyph_cache_store_ =
+      std::vector(draw::glyph_cache::get_size(draw::all_fonts), std::byte{0U});
+  draw::glyph_cache gc_{draw::all_fonts, glyph_cache_store_};
+};
+
+TEST_F(LabelCache, Hit) {
+  std::vector store{draw::label_cache::get_size(draw::sans16, 64U), std::byte{0U}};
+  draw::label_cache lc{gc_, store};
+  EXPECT_FALSE(lc.contains(draw::sans16, u8"Battery"sv));
+  auto const* const first = lc.get(draw::sans16, u8"Battery"sv);
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first->width(), draw::string_width(draw::sans16, u8"Battery"sv));
+  EXPECT_TRUE(lc.contains(draw::sans16, u8"Battery"sv));
+  EXPECT_FALSE(lc.contains(draw::sans32, u8"Battery"sv));
+  EXPECT_EQ(lc.get(draw::sans16, u8"Battery"sv), first);
+}
+
+TEST_F(LabelCache, KeyIncludesFont) {
+  using cache = draw::label_cache;
+  EXPECT_NE(cache::key(draw::sans16.id, u8"Settings"sv), cache::key(draw::sans32.id, u8"Settings"sv));
+  EXPECT_NE(cache::key(draw::sans16.id, u8"Settings"sv), cache::key(draw::sans16.id, u8"settings"sv));
+}
+
+TEST_F(LabelCache, MatchesDrawString) {
+  std::vector store{draw::label_cache::get_size(draw::sans32, 128U), std::byte{0U}};
+  draw::label_cache lc{gc_, store};
+  auto [expected_store, expected] = create_bitmap_and_store(128U, 40U);
+  auto [actual_store, actual] = create_bitmap_and_store(128U, 40U);
+  auto const pos = draw::point{.x = 3, .y = 2};
+  auto const expected_end = expected.draw_string(gc_, draw::sans32, u8"Wavy"sv, pos);
+  EXPECT_EQ(lc.draw(actual, draw::sans32, u8"Wavy"sv, pos), expected_end);
+  EXPECT_EQ(actual_store, expected_store);
+  // A second draw from the cache produces the same result.
+  actual.clear();
+  EXPECT_EQ(lc.draw(actual, draw::sans32, u8"Wavy"sv, pos), expected_end);
+  EXPECT_EQ(actual_store, expected_store);
+}
+
+TEST_F(LabelCache, MatchesDrawString32) {
+  constexpr auto red = draw::rgba{.r = 0xFF, .g = 0x00, .b = 0x00};
+  std::vector store{draw::label_cache::get_size(draw::sans16, 64U), std::byte{0U}};
+  draw::label_cache lc{gc_, store};
+  auto [expected_store, expected] = create_bitmap32_and_store(64U, 20U);
+  auto [actual_store, actual] = create_bitmap32_and_store(64U, 20U);
+  auto const pos = draw::point{.x = -2, .y = 1};
+  auto const expected_end = expected.draw_string(gc_, draw::sans16, u8"mV"sv, pos, red);
+  EXPECT_EQ(lc.draw(actual, draw::sans16, u8"mV"sv, pos, red), expected_end);
+  EXPECT_EQ(actual_store, expected_store);
+}
+
+TEST_F(LabelCache, TooLarge) {
+  // A store with room for labels only 8 pixels wide.
+  std::vector store{draw::label_cache::get_size(draw::sans16, 8U), std::byte{0U}};
+  draw::label_cache lc{gc_, store};
+  EXPECT_EQ(lc.get(draw::sans16, u8"Settings"sv), nullptr);
+  EXPECT_FALSE(lc.contains(draw::sans16, u8"Settings"sv));
+
+  // The label is still drawn, glyph by glyph.
+  auto [expected_store, expected] = create_bitmap_and_store(96U, 16U);
+  auto [actual_store, actual] = create_bitmap_and_store(96U, 16U);
+  auto const pos = draw::point{.x = 0, .y = 0};
+  EXPECT_EQ(lc.draw(actual, draw::sans16, u8"Settings"sv, pos),
+            expected.draw_string(gc_, draw::sans16, u8"Settings"sv, pos));
+  EXPECT_EQ(actual_store, expected_store);
+}
+
+TEST_F(LabelCache, Eviction) {
+  using cache = draw::basic_label_cache<2U, 2U>;
+  // These labels share a cache set.
+  static_assert((cache::key(draw::sans16.id, u8"one"sv) & 1U) == (cache::key(draw::sans16.id, u8"two"sv) & 1U));
+  static_assert((cache::key(draw::sans16.id, u8"one"sv) & 1U) == (cache::key(draw::sans16.id, u8"four"sv) & 1U));
+  std::vector store{cache::get_size(draw::sans16, 64U), std::byte{0U}};
+  cache lc{gc_, store};
+  std::ignore = lc.get(draw::sans16, u8"one"sv);
+  std::ignore = lc.get(draw::sans16, u8"two"sv);
+  std::ignore = lc.get(draw::sans16, u8"one"sv);
+  std::ignore = lc.get(draw::sans16, u8"four"sv);
+  EXPECT_TRUE(lc.contains(draw::sans16, u8"one"sv));
+  EXPECT_FALSE(lc.contains(draw::sans16, u8"two"sv));
+  EXPECT_TRUE(lc.contains(draw::sans16, u8"four"sv));
+
+  // The surviving label is intact after its neighbour was replaced.
+  auto [expected_store, expected] = create_bitmap_and_store(64U, 16U);
+  expected.draw_string(gc_, draw::sans16, u8"one"sv, draw::point{.x = 0, .y = 0});
+  auto const* const one = lc.get(draw::sans16, u8"one"sv);
+  ASSERT_NE(one, nullptr);
+  for (auto y = draw::coordinate{0}; y < static_cast<draw::coordinate>(one->height()); ++y) {
+    for (auto x = draw::coordinate{0}; x < static_cast<draw::coordinate>(one->width()); ++x) {
+      auto const p = draw::point{.x = x, .y = y};
+      EXPECT_EQ(one->get(p), expected.get(p)) << "x=" << x << " y=" << y;
+    }
+  }
+}
+
+}  // end anonymous namespace
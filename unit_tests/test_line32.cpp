@@ -32,6 +32,11 @@
 // DUT
 #include "draw/bitmap32.hpp"
 
+// Standard library
+#include <array>
+#include <cstdint>
+#include <utility>
+
 // Google test/mock
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -196,4 +201,81 @@ TEST(Line32, Diagonal2) {
   EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 0, .left = 0, .bottom = 4, .right = 3}));
 }
 
+constexpr auto white = draw::rgba{.r = 0xFF, .g = 0xFF, .b = 0xFF};
+
+/// \returns Opaque white composited over opaque black with the given coverage.
+constexpr draw::rgba_premult covered(std::uint8_t const c) {
+  return draw::rgba_premult{c, c, c};
+}
+
+TEST(LineAA32, HorizontalIsAliased) {
+  auto [store, bmp] = create_bitmap32_and_store(4U, 3U);
+  bmp.line_aa(draw::point{3, 1}, draw::point{1, 1}, red);
+  EXPECT_THAT(bmp.store(), ElementsAre(x, x, x, x,  // [0]
+                                       x, r, r, r,  // [1]
+                                       x, x, x, x   // [2]
+                                       ));
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 1, .left = 1, .bottom = 1, .right = 3}));
+}
+
+TEST(LineAA32, Shallow) {
+  auto [store, bmp] = create_bitmap32_and_store(5U, 3U);
+  bmp.line_aa(draw::point{0, 0}, draw::point{4, 1}, white);
+  EXPECT_THAT(bmp.store(), ElementsAre(covered(255), covered(191), covered(127), covered(63), x,  // [0]
+                                       x, covered(64), covered(128), covered(192), covered(255),  // [1]
+                                       x, x, x, x, x                                              // [2]
+                                       ));
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 0, .left = 0, .bottom = 1, .right = 4}));
+}
+
+TEST(LineAA32, SteepReversed) {
+  auto [store, bmp] = create_bitmap32_and_store(3U, 5U);
+  bmp.line_aa(draw::point{1, 4}, draw::point{0, 0}, white);
+  EXPECT_THAT(bmp.store(), ElementsAre(covered(255), x, x,             // [0]
+                                       covered(191), covered(64), x,   // [1]
+                                       covered(127), covered(128), x,  // [2]
+                                       covered(63), covered(192), x,   // [3]
+                                       x, covered(255), x              // [4]
+                                       ));
+}
+
+TEST(LineAA32, CoverageSumsToOne) {
+  auto [store, bmp] = create_bitmap32_and_store(40U, 20U);
+  bmp.line_aa(draw::point{1, 2}, draw::point{38, 17}, white);
+  for (auto col = 2U; col < 38U; ++col) {
+    auto sum = 0U;
+    for (auto row = 0U; row < bmp.height(); ++row) {
+      sum += store[row * bmp.stride() + col].r;
+    }
+    EXPECT_EQ(sum, 255U) << "column " << col;
+  }
+}
+
+// Drawing a line that is clipped must produce the same pixels as the corresponding part of the unclipped line.
+TEST(LineAA32, ClippedMatchesUnclipped) {
+  constexpr auto offset = draw::coordinate{40};
+  constexpr auto lines = std::array{
+      std::pair{draw::point{-30, -7}, draw::point{50, 20}}, std::pair{draw::point{-5, 30}, draw::point{20, -40}},
+      std::pair{draw::point{3, -20}, draw::point{9, 33}},   std::pair{draw::point{30, 2}, draw::point{-9, 5}},
+      std::pair{draw::point{-9, 13}, draw::point{25, 14}},  std::pair{draw::point{2, 40}, draw::point{-30, -20}},
+  };
+  auto const shift = [](draw::point const p) {
+    return draw::point{.x = static_cast<draw::coordinate>(p.x + offset),
+                       .y = static_cast<draw::coordinate>(p.y + offset)};
+  };
+  for (auto index = 0U; index < lines.size(); ++index) {
+    auto const& [p0, p1] = lines[index];
+    auto [small_store, small] = create_bitmap32_and_store(16U, 12U);
+    auto [large_store, large] = create_bitmap32_and_store(96U, 92U);
+    small.line_aa(p0, p1, white);
+    large.line_aa(shift(p0), shift(p1), white);
+    for (auto y = 0U; y < small.height(); ++y) {
+      for (auto x = 0U; x < small.width(); ++x) {
+        EXPECT_EQ(small_store[y * small.stride() + x], large_store[(y + offset) * large.stride() + x + offset])
+            << "line " << index << " x=" << x << " y=" << y;
+      }
+    }
+  }
+}
+
 }  // end anonymous namespace
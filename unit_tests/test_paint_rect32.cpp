@@ -0,0 +1,124 @@
+//===- unit_tests/test_paint_rect32.cpp -----------------------------------===//
+//*              _       _                   _   _________   *
+//*  _ __   __ _(_)_ __ | |_   _ __ ___  ___| |_|___ /___ \  *
+//* | '_ \ / _` | | '_ \| __| | '__/ _ \/ __| __| |_ \ __) | *
+//* | |_) | (_| | | | | | |_  | | |  __/ (__| |_ ___) / __/  *
+//* | .__/ \__,_|_|_| |_|\__| |_|  \___|\___|\__|____/_____| *
+//* |_|                                                      *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/bitmap.hpp"
+#include "draw/bitmap32.hpp"
+
+// Standard library
+#include <cstddef>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+
+using testing::Each;
+using testing::ElementsAre;
+
+namespace {
+
+constexpr auto red = draw::rgba{.r = 0xFF, .g = 0x00, .b = 0x00};
+constexpr auto r = draw::rgba_premult{red};
+constexpr auto x = draw::rgba_premult{};
+
+TEST(PaintRect32, AllInsideBlack) {
+  auto [store, bmp] = create_bitmap32_and_store(12U, 4U);
+  bmp.paint_rect(draw::rect{.top = 1, .left = 1, .bottom = 2, .right = 10}, draw::black, red);
+  EXPECT_THAT(bmp.store(), ElementsAre(x, x, x, x, x, x, x, x, x, x, x, x,  // [0]
+                                       x, r, r, r, r, r, r, r, r, r, r, x,  // [1]
+                                       x, r, r, r, r, r, r, r, r, r, r, x,  // [2]
+                                       x, x, x, x, x, x, x, x, x, x, x, x   // [3]
+                                       ));
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 1, .left = 1, .bottom = 2, .right = 10}));
+}
+
+TEST(PaintRect32, AllInsideGray) {
+  auto [store, bmp] = create_bitmap32_and_store(12U, 4U);
+  bmp.paint_rect(draw::rect{.top = 1, .left = 1, .bottom = 2, .right = 10}, draw::gray, red);
+  EXPECT_THAT(bmp.store(), ElementsAre(x, x, x, x, x, x, x, x, x, x, x, x,  // [0]
+                                       x, r, x, r, x, r, x, r, x, r, x, x,  // [1]
+                                       x, x, r, x, r, x, r, x, r, x, r, x,  // [2]
+                                       x, x, x, x, x, x, x, x, x, x, x, x   // [3]
+                                       ));
+}
+
+TEST(PaintRect32, MatchesBitmapBitOrder) {
+  // Every pixel painted in the 32-bit bitmap must correspond to a set pixel in the 1bpp bitmap given the same
+  // rectangle and pattern.
+  constexpr auto width = std::uint16_t{24U};
+  constexpr auto height = std::uint16_t{9U};
+  constexpr auto rc = draw::rect{.top = 0, .left = 3, .bottom = 8, .right = 21};
+  auto [store1, bmp1] = create_bitmap_and_store(width, height);
+  auto [store32, bmp32] = create_bitmap32_and_store(width, height);
+  bmp1.paint_rect(rc, draw::light_gray);
+  bmp32.paint_rect(rc, draw::light_gray, red);
+  for (auto y = 0U; y < height; ++y) {
+    for (auto x0 = 0U; x0 < width; ++x0) {
+      auto const bit = bmp1.store()[y * bmp1.stride() + x0 / 8U] & (std::byte{0x80} >> (x0 % 8U));
+      EXPECT_EQ(bmp32.store()[y * bmp32.stride() + x0], bit != std::byte{0} ? r : x) << "x=" << x0 << " y=" << y;
+    }
+  }
+}
+
+TEST(PaintRect32, Translucent) {
+  constexpr auto blue = draw::rgba_premult{0x00, 0x00, 0xFF};
+  constexpr auto green50 = draw::rgba{.r = 0x00, .g = 0xFF, .b = 0x00, .a = 0x7F};
+  auto expected = blue;
+  expected.composite(draw::rgba_premult{green50});
+
+  auto [store, bmp] = create_bitmap32_and_store(20U, 2U);
+  std::ranges::fill(store, blue);
+  bmp.paint_rect(draw::rect{.top = 0, .left = 0, .bottom = 1, .right = 19}, draw::black, green50);
+  EXPECT_THAT(bmp.store(), Each(expected));
+}
+
+TEST(PaintRect32, Clipped) {
+  auto [store, bmp] = create_bitmap32_and_store(4U, 3U);
+  bmp.paint_rect(draw::rect{.top = -10, .left = -10, .bottom = 1, .right = 20}, draw::black, red);
+  EXPECT_THAT(bmp.store(), ElementsAre(r, r, r, r,  // [0]
+                                       r, r, r, r,  // [1]
+                                       x, x, x, x   // [2]
+                                       ));
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 0, .left = 0, .bottom = 1, .right = 3}));
+}
+
+TEST(PaintRect32, Outside) {
+  auto [store, bmp] = create_bitmap32_and_store(4U, 3U);
+  bmp.paint_rect(draw::rect{.top = 0, .left = 4, .bottom = 2, .right = 8}, draw::black, red);
+  bmp.paint_rect(draw::rect{.top = -4, .left = 0, .bottom = -1, .right = 3}, draw::black, red);
+  EXPECT_THAT(bmp.store(), Each(x));
+  EXPECT_EQ(bmp.dirty(), std::nullopt);
+}
+
+}  // end anonymous namespace
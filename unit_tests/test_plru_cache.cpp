@@ -235,6 +235,16 @@ TEST(PlruCache, Key2x8Uint16) {
   EXPECT_EQ(std::size(cache), 1U);
 }
 
+TEST(PlruCache, Find) {
+  plru_cache<std::uint16_t, std::string, 2, 2> cache;
+  EXPECT_EQ(cache.find(3U), nullptr);
+  std::ignore = cache.access(3U, [](std::uint16_t, std::size_t) { return "three"s; });
+  auto const* const value = cache.find(3U);
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, "three");
+  EXPECT_EQ(cache.find(5U), nullptr);
+}
+
 TEST(PlruCache, BeginEnd) {
   plru_cache<std::uint16_t, std::string, 2, 8> cache;
   EXPECT_EQ(cache.begin(), cache.end());
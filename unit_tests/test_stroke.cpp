@@ -0,0 +1,209 @@
+//===- unit_tests/test_stroke.cpp -----------------------------------------===//
+//*      _             _         *
+//*  ___| |_ _ __ ___ | | _____  *
+//* / __| __| '__/ _ \| |/ / _ \ *
+//* \__ \ |_| | | (_) |   <  __/ *
+//* |___/\__|_|  \___/|_|\_\___| *
+//*                              *
+//===----------------------------------------------------------------------===//
+// SPDX-FileCopyrightText: Copyright © 2026 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+// Permission is hereby granted, free of charge, to any person obtaining
+// a copy of this software and associated documentation files (the
+// “Software”), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be
+// included in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND,
+// EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+// NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+// LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+// OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+// WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//===----------------------------------------------------------------------===//
+
+// DUT
+#include "draw/bitmap32.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Google test/mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Local includes
+#include "create_bitmap.hpp"
+
+using testing::ElementsAre;
+using line_cap = draw::bitmap32::line_cap;
+using line_join = draw::bitmap32::line_join;
+using stroke_style = draw::bitmap32::stroke_style;
+
+namespace {
+
+constexpr auto white = draw::rgba{.r = 0xFF, .g = 0xFF, .b = 0xFF};
+
+// Renders the bitmap as strings with '#' for each pixel that differs from the default and '.' for the rest.
+std::vector<std::string> picture(std::vector<draw::rgba_premult> const& store, std::size_t const width) {
+  std::vector<std::string> result;
+  for (auto row = store.begin(); row != store.end(); row += static_cast<std::ptrdiff_t>(width)) {
+    std::string& s = result.emplace_back();
+    std::ranges::transform(row, row + static_cast<std::ptrdiff_t>(width), std::back_inserter(s),
+                           [](draw::rgba_premult const& px) { return px == draw::rgba_premult{} ? '.' : '#'; });
+  }
+  return result;
+}
+
+TEST(Stroke, ThickHorizontalLine) {
+  auto [store, bmp] = create_bitmap32_and_store(12U, 6U);
+  bmp.stroke_line(draw::point{.x = 2, .y = 2}, draw::point{.x = 8, .y = 2}, stroke_style{.width = 3}, white);
+  EXPECT_THAT(picture(store, 12U), ElementsAre("............",   // [0]
+                                               "..#######...",   // [1]
+                                               "..#######...",   // [2]
+                                               "..#######...",   // [3]
+                                               "............",   // [4]
+                                               "............"));  // [5]
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 1, .left = 2, .bottom = 3, .right = 8}));
+}
+
+TEST(Stroke, EvenWidth) {
+  auto [store, bmp] = create_bitmap32_and_store(6U, 8U);
+  bmp.stroke_line(draw::point{.x = 2, .y = 1}, draw::point{.x = 2, .y = 6}, stroke_style{.width = 2}, white);
+  EXPECT_THAT(picture(store, 6U), ElementsAre("......",   // [0]
+                                              ".##...",   // [1]
+                                              ".##...",   // [2]
+                                              ".##...",   // [3]
+                                              ".##...",   // [4]
+                                              ".##...",   // [5]
+                                              ".##...",   // [6]
+                                              "......"));  // [7]
+}
+
+TEST(Stroke, SquareCap) {
+  auto [store, bmp] = create_bitmap32_and_store(12U, 5U);
+  bmp.stroke_line(draw::point{.x = 2, .y = 2}, draw::point{.x = 8, .y = 2},
+                  stroke_style{.width = 3, .cap = line_cap::square}, white);
+  EXPECT_THAT(picture(store, 12U), ElementsAre("............",   // [0]
+                                               ".#########..",   // [1]
+                                               ".#########..",   // [2]
+                                               ".#########..",   // [3]
+                                               "............"));  // [4]
+}
+
+TEST(Stroke, RoundDot) {
+  auto [store, bmp] = create_bitmap32_and_store(7U, 7U);
+  bmp.stroke_line(draw::point{.x = 3, .y = 3}, draw::point{.x = 3, .y = 3},
+                  stroke_style{.width = 5, .cap = line_cap::round}, white);
+  EXPECT_THAT(picture(store, 7U), ElementsAre(".......",   // [0]
+                                              "..###..",   // [1]
+                                              ".#####.",   // [2]
+                                              ".#####.",   // [3]
+                                              ".#####.",   // [4]
+                                              "..###..",   // [5]
+                                              "......."));  // [6]
+}
+
+class StrokeWidthOne : public testing::TestWithParam<std::tuple<draw::point, draw::point>> {};
+
+TEST_P(StrokeWidthOne, MatchesLine) {
+  auto const [p0, p1] = GetParam();
+  auto [expected_store, expected] = create_bitmap32_and_store(10U, 10U);
+  expected.line(p0, p1, white);
+  auto [store, bmp] = create_bitmap32_and_store(10U, 10U);
+  bmp.stroke_line(p0, p1, stroke_style{}, white);
+  EXPECT_EQ(picture(store, 10U), picture(expected_store, 10U));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Lines, StrokeWidthOne,
+    testing::Values(std::tuple{draw::point{.x = 1, .y = 4}, draw::point{.x = 8, .y = 4}},
+                    std::tuple{draw::point{.x = 3, .y = 8}, draw::point{.x = 3, .y = 0}},
+                    std::tuple{draw::point{.x = 1, .y = 1}, draw::point{.x = 8, .y = 8}},
+                    std::tuple{draw::point{.x = 8, .y = 2}, draw::point{.x = 2, .y = 8}}));
+
+class StrokeRect : public testing::TestWithParam<line_join> {};
+
+TEST_P(StrokeRect, Joins) {
+  auto [store, bmp] = create_bitmap32_and_store(12U, 10U);
+  bmp.stroke_rect(draw::rect{.top = 2, .left = 2, .bottom = 7, .right = 9},
+                  stroke_style{.width = 3, .join = GetParam()}, white);
+  // Only the bevel cuts off the outermost pixel of each corner.
+  auto const c = GetParam() == line_join::bevel ? '.' : '#';
+  auto const corners = std::string{'.', c} + "########" + std::string{c, '.'};
+  EXPECT_THAT(picture(store, 12U), ElementsAre("............",   // [0]
+                                               corners,          // [1]
+                                               ".##########.",   // [2]
+                                               ".##########.",   // [3]
+                                               ".###....###.",   // [4]
+                                               ".###....###.",   // [5]
+                                               ".##########.",   // [6]
+                                               ".##########.",   // [7]
+                                               corners,          // [8]
+                                               "............"));  // [9]
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 1, .left = 1, .bottom = 8, .right = 10}));
+}
+
+INSTANTIATE_TEST_SUITE_P(AllJoins, StrokeRect, testing::Values(line_join::miter, line_join::bevel, line_join::round));
+
+TEST(Stroke, SharpMiterIsBeveled) {
+  // The join of a very sharp corner would be far longer than the stroke is wide.
+  auto [store, bmp] = create_bitmap32_and_store(40U, 12U);
+  std::array const points{draw::point{.x = 2, .y = 2}, draw::point{.x = 30, .y = 5}, draw::point{.x = 2, .y = 8}};
+  bmp.stroke_polyline(points, stroke_style{.width = 3, .join = line_join::miter}, white);
+  auto const pic = picture(store, 40U);
+  EXPECT_TRUE(std::ranges::all_of(pic, [](std::string const& row) { return row.substr(33) == "......."; }));
+}
+
+class StrokeOverlap : public testing::TestWithParam<std::tuple<line_join, line_cap>> {};
+
+TEST_P(StrokeOverlap, PixelsArePaintedOnce) {
+  auto const [join, cap] = GetParam();
+  auto [store, bmp] = create_bitmap32_and_store(40U, 30U);
+  // A zig-zag with sharp corners and a segment that doubles back over its predecessor.
+  std::array const points{draw::point{.x = 3, .y = 3},   draw::point{.x = 20, .y = 25}, draw::point{.x = 25, .y = 4},
+                          draw::point{.x = 36, .y = 20}, draw::point{.x = 30, .y = 20}, draw::point{.x = 34, .y = 20}};
+  constexpr auto translucent = draw::rgba{.r = 0xFF, .g = 0x80, .b = 0x40, .a = 0x80};
+  bmp.stroke_polyline(points, stroke_style{.width = 7, .cap = cap, .join = join}, translucent);
+  auto once = draw::rgba_premult{};
+  once.composite(draw::rgba_premult{translucent});
+  for (auto const& px : store) {
+    EXPECT_TRUE(px == draw::rgba_premult{} || px == once);
+  }
+  EXPECT_NE(std::ranges::count(store, once), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(JoinsAndCaps, StrokeOverlap,
+                         testing::Combine(testing::Values(line_join::miter, line_join::bevel, line_join::round),
+                                          testing::Values(line_cap::butt, line_cap::square, line_cap::round)));
+
+TEST(Stroke, Clipped) {
+  auto [store, bmp] = create_bitmap32_and_store(6U, 4U);
+  bmp.stroke_line(draw::point{.x = -10, .y = 1}, draw::point{.x = 20, .y = 1}, stroke_style{.width = 2}, white);
+  EXPECT_THAT(picture(store, 6U), ElementsAre("######",   // [0]
+                                              "######",   // [1]
+                                              "......",   // [2]
+                                              "......"));  // [3]
+  EXPECT_EQ(bmp.dirty(), (draw::rect{.top = 0, .left = 0, .bottom = 1, .right = 5}));
+}
+
+TEST(Stroke, Outside) {
+  auto [store, bmp] = create_bitmap32_and_store(6U, 4U);
+  bmp.stroke_line(draw::point{.x = -10, .y = 20}, draw::point{.x = 20, .y = 20}, stroke_style{.width = 5}, white);
+  EXPECT_FALSE(bmp.dirty().has_value());
+}
+
+}  // end anonymous namespace